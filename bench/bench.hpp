@@ -0,0 +1,53 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Declares helpers shared by the benchmarks.
+*/
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "header.hpp"
+#include "bus.hpp"
+
+// Draws random hex digits across the screen, clearing whenever key 0 is held.
+const std::vector<uint8_t> DEMO_ROM{
+    0x60, 0x00, 0x61, 0x00, 0xC2, 0x0F, 0xF2, 0x29,
+    0xD0, 0x15, 0x70, 0x03, 0x71, 0x05, 0xE3, 0x9E,
+    0x12, 0x04, 0x00, 0xE0, 0x12, 0x04
+};
+
+class NullBus : public Bus
+{
+    public:
+        void notify(EventData event)
+        {
+            if( event.type == EventType::KEYBOARD_GET ) *event.key = KEY_NOTPRESSED;
+        };
+};
+
+using Clock = std::chrono::steady_clock;
+
+inline double elapsedMs(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Returns an empty vector if the file cannot be read.
+inline std::vector<uint8_t> readRom(const std::string& file)
+{
+    std::ifstream is{file, std::ios_base::in | std::ios_base::binary};
+    if( !is.good() ) return {};
+
+    return { std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>() };
+}
+
+#endif
@@ -0,0 +1,51 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Measures what frame capture costs the emulation thread. Frames are
+    submitted back to back, far faster than the writer can encode them, so
+    the report also shows how many frames the writer dropped.
+
+    Usage: bench_capture [output file] [frames]
+*/
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "bench.hpp"
+#include "capture.hpp"
+
+int main( int argc, char* argv[] )
+{
+    const std::string path{ (argc > 1) ? argv[1] : "bench_capture.y4m" };
+    const std::size_t count{ (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 20000 };
+
+    const uint8_t sprite[5]{0xF0, 0x90, 0xF0, 0x90, 0xF0};
+    Framebuffer framebuffer{};
+
+    Capture capture{path, SCALE};
+    if( !capture.isOpen() )
+    {
+        std::cerr << "Could not open " << path << std::endl;
+        return 1;
+    }
+
+    const Clock::time_point start{ Clock::now() };
+    for( std::size_t i{0}; i < count; ++i )
+    {
+        framebuffer.drawPixelData(static_cast<uint16_t>(i * 5), static_cast<uint16_t>(i * 3), sprite, 5);
+        capture.submit(framebuffer);
+    }
+    const double submit_ms{ elapsedMs(start) };
+
+    capture.close();
+    const double total_ms{ elapsedMs(start) };
+    const CaptureStats stats{ capture.stats() };
+
+    std::cout << "submit      : " << submit_ms * 1e6 / count << " ns/frame" << std::endl;
+    std::cout << "writer      : " << stats.written / (total_ms / 1000) << " frames/s" << std::endl;
+    std::cout << "written     : " << stats.written << " dropped " << stats.dropped
+              << " max queue " << stats.max_queue_depth << std::endl;
+    return 0;
+}
@@ -0,0 +1,61 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Compares the production interpreter against the debug specialization with
+    breakpoints and watchpoints armed that never hit.
+
+    Usage: bench_debug [instructions] [rom file]
+*/
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "bench.hpp"
+#include "chip8.hpp"
+#include "debugger.hpp"
+
+int main( int argc, char* argv[] )
+{
+    const std::size_t count{ (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 20000000 };
+
+    std::vector<uint8_t> rom{ (argc > 2) ? readRom(argv[2]) : DEMO_ROM };
+    if( rom.empty() )
+    {
+        std::cerr << "Could not open " << argv[2] << std::endl;
+        return 1;
+    }
+
+    NullBus bus{};
+    Chip8 cpu{bus};
+    cpu.loadData(MEM_ADDR_START, rom.data(), static_cast<int>(rom.size()));
+    const Chip8State initial{ cpu.getState() };
+
+    const Clock::time_point production_start{ Clock::now() };
+    cpu.cycle(count);
+    const double production_ms{ elapsedMs(production_start) };
+
+    Debugger debugger{};
+    for( uint16_t addr{0x800}; addr < 0x900; addr += 2 ) debugger.setBreakpoint(addr);
+    debugger.watchWrite(0xA00, 64);
+    debugger.watchRead(0xB00, 64);
+
+    cpu.setState(initial);
+    const Clock::time_point debug_start{ Clock::now() };
+    debugger.run(cpu, count);
+    const double debug_ms{ elapsedMs(debug_start) };
+
+    debugger.watchRegister(0xE);
+    cpu.setState(initial);
+    const Clock::time_point register_start{ Clock::now() };
+    debugger.run(cpu, count);
+    const double register_ms{ elapsedMs(register_start) };
+
+    std::cout << "production          : " << (production_ms * 1e6 / count) << " ns/instr" << std::endl;
+    std::cout << "debug, memory armed : " << (debug_ms * 1e6 / count) << " ns/instr ("
+              << (debug_ms / production_ms) << "x)" << std::endl;
+    std::cout << "debug, register too : " << (register_ms * 1e6 / count) << " ns/instr ("
+              << (register_ms / production_ms) << "x)" << std::endl;
+    return 0;
+}
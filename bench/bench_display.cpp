@@ -0,0 +1,67 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Measures the hires display operations SUPER-CHIP and XO-CHIP games lean on:
+    whole screen scrolls and plane masked 16x16 draws. A per pixel scroll over
+    a byte per pixel screen is timed alongside as the reference point.
+
+    Usage: bench_display [iterations]
+*/
+
+#include <array>
+#include <cstdlib>
+#include <iostream>
+
+#include "bench.hpp"
+#include "framebuffer.hpp"
+
+// Scrolls right by 4 one pixel at a time, the way a byte per pixel display would.
+void scrollPerPixel(std::array<uint8_t, HIRES_WIDTH*HIRES_HEIGHT>& screen)
+{
+    for( std::size_t y{0}; y < HIRES_HEIGHT; ++y )
+    {
+        for( std::size_t x{HIRES_WIDTH}; x-- > 0; )
+        {
+            screen[y*HIRES_WIDTH + x] = (x >= 4) ? screen[y*HIRES_WIDTH + x - 4] : 0;
+        }
+    }
+}
+
+int main( int argc, char* argv[] )
+{
+    const std::size_t count{ (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 200000 };
+
+    std::array<uint8_t, 64> sprite{};
+    for( std::size_t i{0}; i < sprite.size(); ++i ) sprite[i] = static_cast<uint8_t>(0xA5 ^ (i * 37));
+
+    Framebuffer framebuffer{};
+    framebuffer.setHires(true);
+    for( uint16_t y{0}; y < HIRES_HEIGHT; y += 16 )
+    {
+        for( uint16_t x{0}; x < HIRES_WIDTH; x += 16 ) framebuffer.drawPixelData(x, y, sprite.data(), 16, false, true, ALL_PLANES);
+    }
+
+    Clock::time_point start{ Clock::now() };
+    for( std::size_t i{0}; i < count; ++i ) framebuffer.scroll((i & 1) ? 4 : -4, 0);
+    std::cout << "00FB/00FC both planes : " << elapsedMs(start) * 1e6 / count << " ns/scroll" << std::endl;
+
+    start = Clock::now();
+    for( std::size_t i{0}; i < count; ++i ) framebuffer.scroll(0, (i & 1) ? 4 : -4);
+    std::cout << "00CN/00DN both planes : " << elapsedMs(start) * 1e6 / count << " ns/scroll" << std::endl;
+
+    start = Clock::now();
+    for( std::size_t i{0}; i < count; ++i )
+    {
+        framebuffer.drawPixelData(static_cast<uint16_t>(i * 7), static_cast<uint16_t>(i * 3), sprite.data(), 16, true, true, ALL_PLANES);
+    }
+    std::cout << "DXY0 both planes      : " << elapsedMs(start) * 1e6 / count << " ns/draw" << std::endl;
+
+    std::array<uint8_t, HIRES_WIDTH*HIRES_HEIGHT> screen{};
+    framebuffer.render(screen.data());
+
+    start = Clock::now();
+    for( std::size_t i{0}; i < count; ++i ) scrollPerPixel(screen);
+    std::cout << "per pixel scroll      : " << elapsedMs(start) * 1e6 / count << " ns/scroll (" << +screen[0] << ")" << std::endl;
+    return 0;
+}
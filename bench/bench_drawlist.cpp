@@ -0,0 +1,162 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Measures draw throughput through the bus applying every display event to
+    the framebuffer as it happens, against deferring them into a DrawList
+    that is presented once per frame. Deferred is timed twice: presenting the
+    shadow, and also replaying the commands onto a presenter's own
+    framebuffer, which needs the commands recorded. Each ROM runs INSTR_PER_BURST instructions a frame, so
+    draw heavy ROMs issue hundreds of sprites per frame. The final hashes of
+    every path must agree.
+
+    Usage: bench_drawlist [frames] [rom files]
+*/
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+#include "chip8.hpp"
+#include "drawlist.hpp"
+#include "framebuffer.hpp"
+
+#define INSTR_PER_BURST 1000
+
+// Draws a sprite, draws it again to erase it and moves one pixel right, the
+// way a ROM animates.
+const std::vector<uint8_t> ERASE_ROM{
+    0xA2, 0x0A, 0xD0, 0x18, 0xD0, 0x18, 0x70, 0x01,
+    0x12, 0x02, 0x3C, 0x7E, 0xFF, 0xDB, 0xFF, 0x66,
+    0x3C, 0x18
+};
+
+// A few sprites drawn and left, then the screen cleared: a redraw every frame.
+const std::vector<uint8_t> REDRAW_ROM{
+    0x00, 0xE0, 0x61, 0x00, 0x60, 0x00, 0xA2, 0x18,
+    0xD0, 0x18, 0x70, 0x09, 0x30, 0x3F, 0x12, 0x08,
+    0x71, 0x09, 0x31, 0x1B, 0x12, 0x04, 0x12, 0x00,
+    0x3C, 0x7E, 0xFF, 0xDB, 0xFF, 0x66, 0x3C, 0x18
+};
+
+class DrawBus : public Bus
+{
+    public:
+        Chip8 cpu;
+        Framebuffer framebuffer{};
+        DrawList* draws{};
+        uint64_t drawn{};
+
+        DrawBus(DrawList* draws) :
+            cpu(*this),
+            draws(draws)
+        {
+            if( draws ) draws->reset(framebuffer);
+        };
+
+        template<typename Target>
+        void display(Target& target, const EventData& event)
+        {
+            switch( event.type )
+            {
+                case EventType::DISPLAY_CLEAR:
+                    target.clearScreen(event.planes);
+                    break;
+                case EventType::DISPLAY_DRAW:
+                    ++drawn;
+                    cpu.setStatusReg(target.drawPixelData(event.draw.xpos, event.draw.ypos, event.draw.data,
+                        event.draw.size, event.draw.wrap, event.draw.wide, event.draw.planes));
+                    break;
+                case EventType::DISPLAY_SCROLL:
+                    target.scroll(event.scroll.dx, event.scroll.dy, event.scroll.planes);
+                    break;
+                case EventType::DISPLAY_MODE:
+                    target.setHires(event.hires);
+                    break;
+                default:
+                    break;
+            }
+        };
+
+        void notify(EventData event)
+        {
+            if( event.type == EventType::KEYBOARD_GET ) *event.key = KEY_NOTPRESSED;
+            else if( event.type == EventType::RANDOM ) *event.random.dest = event.random.mask & 0x5A;
+            else if( draws ) display(*draws, event);
+            else display(framebuffer, event);
+        };
+};
+
+struct PathResult
+{
+    double ms{};
+    uint64_t drawn{};
+    uint64_t hash{};
+};
+
+// Mode 0 applies events as they come, 1 presents a draw list, 2 also replays it.
+PathResult runPath(const std::vector<uint8_t>& rom, std::size_t frames, int mode)
+{
+    DrawList draws{};
+    draws.setRecording(mode == 2);
+    DrawBus bus{ mode == 0 ? nullptr : &draws };
+    bus.cpu.loadData(MEM_ADDR_START, rom.data(), static_cast<int>(rom.size()));
+
+    Framebuffer presenter{};
+
+    const Clock::time_point start{ Clock::now() };
+    for( std::size_t frame{0}; frame < frames; ++frame )
+    {
+        bus.cpu.cycle(INSTR_PER_BURST);
+        bus.cpu.tickTimer();
+
+        if( mode == 2 ) draws.replay(presenter);
+        if( mode != 0 ) draws.present(bus.framebuffer);
+    }
+    const double ms{ elapsedMs(start) };
+
+    // With a replay, the presenter's copy is the one checked.
+    return { ms, bus.drawn, (mode == 2) ? presenter.hash() : bus.framebuffer.hash() };
+}
+
+void report(const std::string& name, const PathResult& result, double baseline_ms)
+{
+    std::cout << "  " << std::left << std::setw(22) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(8) << result.ms * 1e6 / std::max<uint64_t>(result.drawn, 1) << " ns/draw "
+              << std::setprecision(2) << std::setw(6) << baseline_ms / result.ms << "x  hash " << std::hex
+              << result.hash << std::dec << std::endl;
+}
+
+void measure(const std::string& name, const std::vector<uint8_t>& rom, std::size_t frames)
+{
+    const PathResult direct{ runPath(rom, frames, 0) };
+    const PathResult deferred{ runPath(rom, frames, 1) };
+    const PathResult replayed{ runPath(rom, frames, 2) };
+
+    std::cout << name << ": " << direct.drawn / frames << " draws/frame" << std::endl;
+    report("per event", direct, direct.ms);
+    report("deferred, present", deferred, direct.ms);
+    report("deferred, + replay", replayed, direct.ms);
+
+    if( deferred.hash != direct.hash || replayed.hash != direct.hash ) std::cout << "  HASH MISMATCH" << std::endl;
+}
+
+int main( int argc, char* argv[] )
+{
+    const std::size_t frames{ (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 2000 };
+
+    measure("demo", DEMO_ROM, frames);
+    measure("erase and redraw", ERASE_ROM, frames);
+    measure("clear and redraw", REDRAW_ROM, frames);
+
+    for( int i{2}; i < argc; ++i )
+    {
+        const std::vector<uint8_t> rom{ readRom(argv[i]) };
+        if( rom.empty() ) std::cerr << "Could not read " << argv[i] << std::endl;
+        else measure(argv[i], rom, frames);
+    }
+    return 0;
+}
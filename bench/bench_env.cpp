@@ -0,0 +1,66 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Measures VecEnv throughput in batched steps per second. Runs a built-in
+    sprite drawing loop unless a ROM file is given.
+
+    Usage: bench_env [instances] [frames per step] [threads] [rom file]
+*/
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "bench.hpp"
+#include "env.hpp"
+
+int main( int argc, char* argv[] )
+{
+    const std::size_t count{ (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 1024 };
+    const std::size_t frames_per_step{ (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 4 };
+    const std::size_t threads{ (argc > 3) ? std::strtoul(argv[3], nullptr, 10) : 0 };
+
+    std::vector<uint8_t> rom{ DEMO_ROM };
+    if( argc > 4 )
+    {
+        rom = readRom(argv[4]);
+        if( rom.empty() )
+        {
+            std::cerr << "Could not open " << argv[4] << std::endl;
+            return 1;
+        }
+    }
+
+    VecEnv env{count, frames_per_step, threads, 1};
+    if( !env.loadProgram(rom.data(), rom.size()) )
+    {
+        std::cerr << "ROM does not fit in memory" << std::endl;
+        return 1;
+    }
+
+    std::vector<uint16_t> actions(count);
+    std::vector<uint8_t> frames(count * ENV_FRAME_SIZE);
+    std::vector<uint8_t> done(count);
+
+    for( std::size_t i{0}; i < 10; ++i ) env.step(actions.data(), frames.data(), done.data());
+
+    const Clock::time_point start{ Clock::now() };
+
+    std::size_t steps{0};
+    double seconds{0};
+    while( seconds < 2.0 )
+    {
+        for( std::size_t i{0}; i < count; ++i ) actions[i] = static_cast<uint16_t>((steps + i) % 3 == 0);
+        env.step(actions.data(), frames.data(), done.data());
+
+        ++steps;
+        seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    std::cout << count << " instances, " << frames_per_step << " frames/step" << std::endl;
+    std::cout << (steps / seconds) << " batched steps/s" << std::endl;
+    std::cout << (steps * count / seconds) << " instance steps/s" << std::endl;
+    std::cout << (steps * count * frames_per_step / seconds) << " emulated frames/s" << std::endl;
+    return 0;
+}
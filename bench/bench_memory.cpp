@@ -0,0 +1,120 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Measures the masked memory accessors of Chip8State against raw pointer
+    access and against a per-byte bounds check, on the access patterns of
+    the interpreter: two-byte fetches, FX65 sized reads, DXYN sized sprite
+    reads and FX55 stores that keep memory_hash up to date. Raw access is
+    only safe because every address here stays MEM_GUARD bytes below the end.
+
+    Usage: bench_memory [iterations]
+*/
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+#include "hash.hpp"
+#include "random.hpp"
+#include "state.hpp"
+
+// Keeps the compiler from dropping the loops.
+volatile uint64_t sink{};
+
+template<typename Access>
+void measure(const std::string& name, const std::vector<uint16_t>& addrs, std::size_t iterations, Access access)
+{
+    uint64_t total{0};
+    const Clock::time_point start{ Clock::now() };
+    for( std::size_t i{0}; i < iterations; ++i )
+    {
+        for( uint16_t addr : addrs ) total += access(addr);
+    }
+    const double ms{ elapsedMs(start) };
+    sink = total;
+
+    std::cout << "  " << std::left << std::setw(26) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(7) << ms * 1e6 / (static_cast<double>(iterations) * addrs.size()) << " ns/access" << std::endl;
+}
+
+int main( int argc, char* argv[] )
+{
+    const std::size_t iterations{ (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 2000 };
+
+    Chip8State state{};
+    state.reset();
+
+    Random random{7};
+    for( std::size_t addr{MEM_ADDR_START}; addr < MEM_SIZE; ++addr ) state.write(static_cast<uint16_t>(addr), random.next());
+
+    std::vector<uint16_t> addrs(4096);
+    for( uint16_t& addr : addrs ) addr = static_cast<uint16_t>(random.next64() % (MEM_SIZE - MEM_GUARD));
+
+    uint8_t* raw{ state.memory.data() };
+
+    std::cout << "fetch, two bytes" << std::endl;
+    measure("raw pointer", addrs, iterations, [&](uint16_t addr) { return (raw[addr] << 8) | raw[addr + 1]; });
+    measure("bounds checked", addrs, iterations, [&](uint16_t addr)
+    {
+        return ((addr < MEM_SIZE ? raw[addr] : 0) << 8) | (addr + 1 < MEM_SIZE ? raw[addr + 1] : 0);
+    });
+    measure("masked span", addrs, iterations, [&](uint16_t addr)
+    {
+        const uint8_t* bytes{ state.span(addr) };
+        return (bytes[0] << 8) | bytes[1];
+    });
+    measure("masked read per byte", addrs, iterations, [&](uint16_t addr) { return (state.read(addr) << 8) | state.read(addr + 1); });
+
+    // FX65 with X = F reads 16 bytes, DXY0 on both planes 64.
+    for( std::size_t size : { 16u, 64u } )
+    {
+        std::cout << size << " byte reads" << std::endl;
+        measure("raw pointer", addrs, iterations / 8, [&](uint16_t addr)
+        {
+            uint32_t sum{0};
+            for( std::size_t i{0}; i < size; ++i ) sum += raw[addr + i];
+            return sum;
+        });
+        measure("bounds checked", addrs, iterations / 8, [&](uint16_t addr)
+        {
+            uint32_t sum{0};
+            for( std::size_t i{0}; i < size; ++i ) sum += (addr + i < MEM_SIZE) ? raw[addr + i] : 0;
+            return sum;
+        });
+        measure("masked span", addrs, iterations / 8, [&](uint16_t addr)
+        {
+            const uint8_t* bytes{ state.span(addr) };
+            uint32_t sum{0};
+            for( std::size_t i{0}; i < size; ++i ) sum += bytes[i];
+            return sum;
+        });
+    }
+
+    // Stores are hashed on both sides, as FX55 must keep memory_hash current.
+    std::cout << "FX55 stores, 16 bytes" << std::endl;
+    uint64_t raw_hash{ state.memory_hash };
+    measure("raw pointer + hash", addrs, iterations / 8, [&](uint16_t addr)
+    {
+        for( uint16_t i{0}; i < 16; ++i )
+        {
+            const uint8_t value{ static_cast<uint8_t>(addr + i) };
+            raw_hash ^= memoryKey(addr + i, raw[addr + i]) ^ memoryKey(addr + i, value);
+            raw[addr + i] = value;
+        }
+        return raw_hash;
+    });
+    state.rehashMemory();
+    measure("masked write", addrs, iterations / 8, [&](uint16_t addr)
+    {
+        for( uint16_t i{0}; i < 16; ++i ) state.write(addr + i, static_cast<uint8_t>(addr + i + 1));
+        return state.memory_hash;
+    });
+
+    std::cout << "(memory hash " << std::hex << state.memory_hash << std::dec << ", matches "
+              << (state.memory_hash == hashMemory(state.memory.data(), MEM_SIZE)) << ")" << std::endl;
+    return 0;
+}
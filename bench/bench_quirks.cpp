@@ -0,0 +1,60 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Measures each quirk profile's interpreter loop on a ROM that exercises the
+    quirky instructions. The DEFAULT profile is the behaviour the interpreter
+    has always had, and the per-instruction execute(fetch()) loop shows what a
+    runtime quirk check costs.
+
+    Usage: bench_quirks [instructions]
+*/
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "bench.hpp"
+#include "chip8.hpp"
+
+// Shifts, logic ops, FX55/FX65 and a draw in a loop. I is reset every
+// iteration so the load/store quirks stay inside the scratch area.
+const std::vector<uint8_t> QUIRK_ROM{
+    0x60, 0x01, 0x61, 0x02, 0xA3, 0x00, 0x80, 0x16,
+    0x81, 0x1E, 0x80, 0x11, 0x81, 0x02, 0xF1, 0x55,
+    0xA3, 0x00, 0xF1, 0x65, 0x70, 0x07, 0xD0, 0x11,
+    0x12, 0x04
+};
+
+double nsPerInstruction(Chip8& cpu, Profile profile, std::size_t count)
+{
+    cpu.reset();
+    cpu.loadData(MEM_ADDR_START, QUIRK_ROM.data(), static_cast<int>(QUIRK_ROM.size()));
+    cpu.setProfile(profile);
+
+    std::size_t executed{0};
+    const Clock::time_point start{ Clock::now() };
+    while( executed < count ) executed += cpu.cycle(INSTR_PER_FRAME);
+    return elapsedMs(start) * 1e6 / executed;
+}
+
+int main( int argc, char* argv[] )
+{
+    const std::size_t count{ (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 20000000 };
+
+    NullBus bus{};
+    Chip8 cpu{bus};
+
+    cpu.loadData(MEM_ADDR_START, QUIRK_ROM.data(), static_cast<int>(QUIRK_ROM.size()));
+    const Clock::time_point start{ Clock::now() };
+    for( std::size_t i{0}; i < count; ++i ) cpu.execute(cpu.fetch());
+    const double runtime_ns{ elapsedMs(start) * 1e6 / count };
+
+    std::cout << "execute(fetch()) loop : " << runtime_ns << " ns/instr" << std::endl;
+    std::cout << "cycle() DEFAULT       : " << nsPerInstruction(cpu, Profile::DEFAULT, count) << " ns/instr" << std::endl;
+    std::cout << "cycle() COSMAC_VIP    : " << nsPerInstruction(cpu, Profile::COSMAC_VIP, count) << " ns/instr" << std::endl;
+    std::cout << "cycle() CHIP_48       : " << nsPerInstruction(cpu, Profile::CHIP_48, count) << " ns/instr" << std::endl;
+    std::cout << "cycle() SUPER_CHIP    : " << nsPerInstruction(cpu, Profile::SUPER_CHIP, count) << " ns/instr" << std::endl;
+    std::cout << "cycle() XO_CHIP       : " << nsPerInstruction(cpu, Profile::XO_CHIP, count) << " ns/instr" << std::endl;
+    return 0;
+}
@@ -0,0 +1,135 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Measures loading a directory of ROMs the old way against the ROM library.
+    The old way reads each file with an ifstream and analyses it. The library
+    maps and hashes every file, then looks up each analysis: cold with an
+    empty cache, warm from its cache file in a fresh instance, and warm in
+    memory on a second pass. Mapping and lookups are timed separately.
+
+    Without a directory, ROM_COUNT generated programs padded with random data
+    are written to a temporary directory first, a quarter of them duplicates.
+
+    Usage: bench_romlib [directory]
+*/
+
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+#include "fuzz.hpp"
+#include "library.hpp"
+#include "random.hpp"
+
+#define ROM_COUNT 4000
+
+std::filesystem::path generateRoms()
+{
+    const std::filesystem::path directory{ std::filesystem::temp_directory_path() / "chip8_bench_roms" };
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+
+    ProgramGenerator generator{1, { Profile::DEFAULT, Profile::SUPER_CHIP, Profile::XO_CHIP }, 1000};
+    Random random{2};
+
+    std::vector<uint8_t> rom{};
+    for( std::size_t i{0}; i < ROM_COUNT; ++i )
+    {
+        // Every fourth ROM repeats the one before it under a new name.
+        if( i % 4 != 3 )
+        {
+            rom = generator.next().program;
+            const std::size_t size{ 512 + random.next64() % (ROM_MAX_SIZE - 512) };
+            while( rom.size() < size ) rom.push_back(static_cast<uint8_t>(random.next()));
+            rom.resize(size);
+        }
+
+        std::ofstream os{directory / ("rom" + std::to_string(i) + ROM_EXTENSION), std::ios_base::out | std::ios_base::binary};
+        os.write(reinterpret_cast<const char*>(rom.data()), static_cast<std::streamsize>(rom.size()));
+    }
+    return directory;
+}
+
+void report(const std::string& name, double ms, std::size_t roms)
+{
+    std::cout << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(1) << std::setw(9)
+              << ms << " ms " << std::setprecision(2) << std::setw(8) << ms * 1000 / roms << " us/rom" << std::endl;
+}
+
+int main( int argc, char* argv[] )
+{
+    const bool generated{ argc < 2 };
+    const std::filesystem::path directory{ generated ? generateRoms() : std::filesystem::path{argv[1]} };
+    const std::filesystem::path cache{ std::filesystem::temp_directory_path() / "chip8_bench_roms.cache" };
+    std::filesystem::remove(cache);
+
+    std::vector<std::string> paths{};
+    for( const std::filesystem::directory_entry& entry : std::filesystem::recursive_directory_iterator(directory) )
+    {
+        if( entry.is_regular_file() && entry.path().extension() == ROM_EXTENSION ) paths.push_back(entry.path().string());
+    }
+    if( paths.empty() )
+    {
+        std::cerr << "No " << ROM_EXTENSION << " files in " << directory.string() << std::endl;
+        return 1;
+    }
+
+    uint64_t checksum{0};
+
+    // What every load did before: read the file, then work everything out again.
+    Clock::time_point start{ Clock::now() };
+    for( const std::string& path : paths )
+    {
+        std::ifstream is{path, std::ios_base::in | std::ios_base::binary};
+        const std::vector<uint8_t> rom{ std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>() };
+        checksum += analyzeRom(rom.data(), rom.size()).blocks.size();
+    }
+    report("ifstream + analysis", elapsedMs(start), paths.size());
+
+    {
+        start = Clock::now();
+        RomLibrary library{cache.string()};
+        library.scan(directory.string());
+        report("library map + hash", elapsedMs(start), library.size());
+
+        start = Clock::now();
+        for( std::size_t i{0}; i < library.size(); ++i ) checksum += library.analysis(library.image(i)).blocks.size();
+        report("library analysis, cold", elapsedMs(start), library.size());
+
+        start = Clock::now();
+        for( std::size_t i{0}; i < library.size(); ++i ) checksum += library.analysis(library.image(i)).blocks.size();
+        report("library analysis, in memory", elapsedMs(start), library.size());
+
+        start = Clock::now();
+        library.save();
+        report("  saving the cache", elapsedMs(start), library.size());
+
+        const RomLibraryStats stats{ library.stats() };
+        std::cout << "  " << stats.roms << " roms, " << stats.analysed << " distinct, "
+                  << std::filesystem::file_size(cache) << " byte cache" << std::endl;
+    }
+
+    {
+        start = Clock::now();
+        RomLibrary library{cache.string()};
+        report("  loading the cache", elapsedMs(start), paths.size());
+
+        library.scan(directory.string());
+        start = Clock::now();
+        for( std::size_t i{0}; i < library.size(); ++i ) checksum += library.analysis(library.image(i)).blocks.size();
+        report("library analysis, cache file", elapsedMs(start), library.size());
+        std::cout << "  " << library.stats().disk_hits << " disk hits, " << library.stats().analysed << " analysed" << std::endl;
+    }
+
+    std::cout << "(checksum " << checksum << ")" << std::endl;
+
+    std::filesystem::remove(cache);
+    if( generated ) std::filesystem::remove_all(directory);
+    return 0;
+}
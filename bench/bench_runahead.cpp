@@ -0,0 +1,170 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Measures, per ROM, how many frames the ROM itself takes to show a key
+    press and how many of them run-ahead hides, and what the speculative
+    frames and snapshots cost on top of the real frame.
+
+    A ROM's lag is the number of frames shown from a press to the first one
+    that differs from a run without it, taken as the median over presses at
+    several frames and the fastest key. It is measured on the frames
+    run-ahead shows, once per setting, and what a setting removes is its lag
+    subtracted from the lag without run-ahead.
+
+    Usage: bench_runahead [rom files]
+*/
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+#include "chip8.hpp"
+#include "framebuffer.hpp"
+#include "random.hpp"
+#include "runahead.hpp"
+
+#define LAG_LIMIT 120
+
+// Waits for a key and draws its digit, moving right after each one.
+const std::vector<uint8_t> KEY_ROM{
+    0x6B, 0x00, 0x6C, 0x00, 0xF0, 0x0A, 0xF0, 0x29,
+    0xDB, 0xC5, 0x7B, 0x05, 0x12, 0x04
+};
+
+// Reads key 5 once every three frames, paced by the delay timer, and draws
+// a digit when it is held: the input lag of a typical game loop.
+const std::vector<uint8_t> PACED_ROM{
+    0x6B, 0x00, 0x60, 0x03, 0xF0, 0x15, 0xF1, 0x07,
+    0x31, 0x00, 0x12, 0x06, 0x62, 0x05, 0xE2, 0xA1,
+    0x12, 0x14, 0x12, 0x02, 0xF2, 0x29, 0xDB, 0x05,
+    0x7B, 0x05, 0x12, 0x02
+};
+
+class RunAheadBus : public Bus
+{
+    public:
+        Chip8 cpu;
+        Framebuffer framebuffer{};
+        Random random{1};
+        uint8_t key{KEY_NOTPRESSED};
+
+        RunAheadBus(const std::vector<uint8_t>& rom) :
+            cpu(*this)
+        {
+            cpu.loadData(MEM_ADDR_START, rom.data(), static_cast<int>(rom.size()));
+        };
+
+        void notify(EventData event)
+        {
+            switch(event.type)
+            {
+                case EventType::DISPLAY_CLEAR:
+                    framebuffer.clearScreen(event.planes);
+                    break;
+                case EventType::DISPLAY_DRAW:
+                    cpu.setStatusReg(framebuffer.drawPixelData(event.draw.xpos, event.draw.ypos, event.draw.data,
+                        event.draw.size, event.draw.wrap, event.draw.wide, event.draw.planes));
+                    break;
+                case EventType::DISPLAY_SCROLL:
+                    framebuffer.scroll(event.scroll.dx, event.scroll.dy, event.scroll.planes);
+                    break;
+                case EventType::DISPLAY_MODE:
+                    framebuffer.setHires(event.hires);
+                    break;
+                case EventType::KEYBOARD_GET:
+                    *event.key = key;
+                    break;
+                case EventType::RANDOM:
+                    *event.random.dest = event.random.mask & random.next();
+                    break;
+            }
+        };
+};
+
+// Frames shown from pressing key before frame press until the shown screen
+// differs, 0 if it never does.
+std::size_t lag(const std::vector<uint8_t>& rom, std::size_t ahead, uint8_t key, std::size_t press)
+{
+    RunAheadBus idle{rom}, pressed{rom};
+    RunAhead idle_ahead{idle.cpu, idle.framebuffer, idle.random, ahead};
+    RunAhead pressed_ahead{pressed.cpu, pressed.framebuffer, pressed.random, ahead};
+    for( std::size_t i{0}; i < press; ++i )
+    {
+        idle_ahead.step();
+        pressed_ahead.step();
+    }
+
+    pressed.key = key;
+    for( std::size_t frames{1}; frames <= LAG_LIMIT; ++frames )
+    {
+        const uint64_t shown_idle{ idle_ahead.step().hash() };
+        if( shown_idle != pressed_ahead.step().hash() ) return frames;
+    }
+    return 0;
+}
+
+std::size_t medianLag(const std::vector<uint8_t>& rom, std::size_t ahead)
+{
+    std::size_t best{0};
+    for( uint8_t key{0}; key < 16; ++key )
+    {
+        std::vector<std::size_t> lags{};
+        for( std::size_t press{30}; press < 90; press += 7 ) lags.push_back(lag(rom, ahead, key, press));
+
+        std::sort(lags.begin(), lags.end());
+        const std::size_t median{ lags[lags.size() / 2] };
+        if( median > 0 && (best == 0 || median < best) ) best = median;
+    }
+    return best;
+}
+
+void report(const std::string& name, const std::vector<uint8_t>& rom)
+{
+    const std::size_t frames_lag{ medianLag(rom, 0) };
+
+    std::cout << name << ": ";
+    if( frames_lag == 0 ) std::cout << "no key changed the screen within " << LAG_LIMIT << " frames" << std::endl;
+    else std::cout << "shows a press after " << frames_lag << " frames" << std::endl;
+
+    for( std::size_t ahead : { 0, 1, 2, 4 } )
+    {
+        RunAheadBus bus{rom};
+        RunAhead runahead{bus.cpu, bus.framebuffer, bus.random, ahead};
+
+        const Clock::time_point start{ Clock::now() };
+        for( std::size_t i{0}; i < 20000; ++i ) runahead.step();
+        const double ns{ elapsedMs(start) * 1e6 / 20000 };
+
+        const RunAheadStats& stats{ runahead.getStats() };
+        const std::size_t shown_lag{ medianLag(rom, ahead) };
+
+        std::cout << "  runahead " << ahead << ": " << std::fixed << std::setprecision(0) << std::setw(6) << ns
+                  << " ns/frame (snapshots " << std::setw(4) << stats.snapshot_ns / stats.frames << " ns), ";
+        if( frames_lag == 0 || shown_lag == 0 ) std::cout << "no lag measured" << std::endl;
+        else if( shown_lag >= frames_lag ) std::cout << "measured lag " << shown_lag << ", removes none" << std::endl;
+        else std::cout << "measured lag " << shown_lag << ", removes " << frames_lag - shown_lag << " frames" << std::endl;
+    }
+}
+
+int main( int argc, char* argv[] )
+{
+    report("demo rom", DEMO_ROM);
+    report("key wait rom", KEY_ROM);
+    report("timer paced rom", PACED_ROM);
+
+    for( int i{1}; i < argc; ++i )
+    {
+        const std::vector<uint8_t> rom{ readRom(argv[i]) };
+        if( rom.empty() )
+        {
+            std::cerr << "Could not read " << argv[i] << std::endl;
+            continue;
+        }
+        report(argv[i], rom);
+    }
+    return 0;
+}
@@ -0,0 +1,124 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Measures the savestate store on a checkpoint taken every frame of a ROM:
+    how many chunk references each stored chunk serves, the pack bytes per
+    checkpoint against a full image, and checkpoints per second written with
+    an fsync per group and with one per checkpoint, and read back in order
+    and at random.
+
+    Usage: bench_savestate [frames] [rom files]
+*/
+
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+#include "fuzz.hpp"
+#include "random.hpp"
+#include "savestate.hpp"
+
+// Keeps the compiler from dropping the reads.
+volatile uint64_t sink{};
+
+std::vector<Snapshot> record(const std::vector<uint8_t>& rom, std::size_t frames)
+{
+    FuzzBus bus{ FuzzCase{ .program = rom, .seed = 1, .profile = Profile::DEFAULT } };
+
+    std::vector<Snapshot> snapshots{};
+    snapshots.reserve(frames);
+    for( std::size_t frame{0}; frame < frames; ++frame )
+    {
+        bus.cpu.cycle(INSTR_PER_FRAME);
+        bus.cpu.tickTimer();
+        snapshots.push_back({ bus.cpu.getState(), bus.framebuffer, bus.random });
+    }
+    return snapshots;
+}
+
+void report(const std::string& name, double ms, std::size_t count)
+{
+    std::cout << "  " << std::left << std::setw(22) << name << std::right << std::fixed << std::setprecision(0)
+              << std::setw(10) << count * 1000.0 / ms << " checkpoints/s" << std::endl;
+}
+
+// Returns the store's stats after writing every snapshot.
+SaveStoreStats write(const std::string& name, const std::filesystem::path& path,
+    const std::vector<Snapshot>& snapshots, std::size_t group)
+{
+    std::filesystem::remove(path);
+    SaveStore store{path.string(), group};
+
+    const Clock::time_point start{ Clock::now() };
+    for( const Snapshot& snapshot : snapshots ) store.put(snapshot);
+    store.flush();
+    report(name, elapsedMs(start), snapshots.size());
+
+    return store.stats();
+}
+
+void measure(const std::string& name, const std::vector<uint8_t>& rom, std::size_t frames)
+{
+    const std::vector<Snapshot> snapshots{ record(rom, frames) };
+    const std::filesystem::path path{ std::filesystem::temp_directory_path() / "bench_savestate.pack" };
+
+    std::cout << name << ", " << frames << " checkpoints" << std::endl;
+
+    // An fsync per checkpoint dominates, so it only gets a slice of them.
+    const std::vector<Snapshot> slice{ snapshots.begin(), snapshots.begin() + std::min<std::size_t>(frames, 200) };
+    write("write, fsync each", path, slice, 1);
+    const SaveStoreStats stats{ write("write, fsync per 256", path, snapshots, SAVE_GROUP) };
+
+    {
+        SaveStore store{path.string()};
+        Snapshot loaded{};
+
+        Clock::time_point start{ Clock::now() };
+        for( std::size_t i{0}; i < store.size(); ++i )
+        {
+            store.get(i, loaded);
+            sink = loaded.cpu.pc;
+        }
+        report("read, in order", elapsedMs(start), store.size());
+
+        Random random{3};
+        start = Clock::now();
+        for( std::size_t i{0}; i < store.size(); ++i )
+        {
+            store.get(random.next64() % store.size(), loaded);
+            sink = loaded.cpu.pc;
+        }
+        report("read, at random", elapsedMs(start), store.size());
+    }
+
+    std::cout << "  dedup ratio " << std::setprecision(1)
+              << static_cast<double>(stats.chunk_refs) / static_cast<double>(stats.chunks)
+              << "x (" << stats.chunks << " chunks for " << stats.chunk_refs << " references), "
+              << std::setprecision(0) << static_cast<double>(stats.pack_bytes) / static_cast<double>(stats.checkpoints)
+              << " bytes per checkpoint against " << SAVE_IMAGE_SIZE << ", " << stats.syncs << " fsyncs" << std::endl;
+
+    std::filesystem::remove(path);
+}
+
+int main( int argc, char* argv[] )
+{
+    const std::size_t frames{ (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 10000 };
+
+    measure("demo ROM", DEMO_ROM, frames);
+    for( int i{2}; i < argc; ++i )
+    {
+        const std::vector<uint8_t> rom{ readRom(argv[i]) };
+        if( rom.empty() )
+        {
+            std::cerr << "Cannot read " << argv[i] << std::endl;
+            continue;
+        }
+        measure(argv[i], rom, frames);
+    }
+    return 0;
+}
@@ -0,0 +1,63 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Measures how long the emulator takes to start, run one frame and exit in
+    headless mode. When the SDL frontend is built, also measures what the
+    windowed startup spends in SDL_Init alone.
+
+    Usage: bench_startup [runs]
+*/
+
+#ifdef CHIP8_SDL
+#include <SDL2/SDL.h>
+#endif
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "bench.hpp"
+
+#ifdef _WIN32
+#define NULL_DEVICE "NUL"
+#else
+#define NULL_DEVICE "/dev/null"
+#endif
+
+int main( int argc, char* argv[] )
+{
+    const int runs{ (argc > 1) ? std::atoi(argv[1]) : 20 };
+
+    const std::string rom_file{ "bench_startup_rom.ch8" };
+    {
+        std::ofstream os{rom_file, std::ios_base::out | std::ios_base::binary};
+        os.write(reinterpret_cast<const char*>(DEMO_ROM.data()), DEMO_ROM.size());
+    }
+
+    const std::string command{ std::string("\"") + MAIN_EXECUTABLE + "\" --headless --frames 1 "
+        + rom_file + " > " + NULL_DEVICE };
+
+    if( std::system(command.c_str()) != 0 )
+    {
+        std::cerr << "Could not run " << command << std::endl;
+        return 1;
+    }
+
+    const Clock::time_point start{ Clock::now() };
+    for( int i{0}; i < runs; ++i ) std::system(command.c_str());
+    std::cout << "headless start + 1 frame + exit: " << (elapsedMs(start) / runs) << " ms" << std::endl;
+
+#ifdef CHIP8_SDL
+    const Clock::time_point sdl_start{ Clock::now() };
+    SDL_Init( SDL_INIT_EVERYTHING );
+    const double sdl_ms{ elapsedMs(sdl_start) };
+    SDL_Quit();
+    std::cout << "SDL_Init(SDL_INIT_EVERYTHING) alone: " << sdl_ms << " ms" << std::endl;
+#endif
+
+    std::remove(rom_file.c_str());
+    return 0;
+}
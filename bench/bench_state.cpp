@@ -0,0 +1,72 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Measures the footprint and creation cost of Chip8 instances. Compares one
+    heap allocation per Chip8 against bulk creation through StatePool.
+
+    Usage: bench_state [instance count]
+*/
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "bench.hpp"
+#include "chip8.hpp"
+#include "pool.hpp"
+#include "state.hpp"
+
+void report(const char* name, std::size_t count, double ms)
+{
+    std::cout << name << ": " << ms << " ms (" << (ms * 1e6 / count) << " ns/instance)" << std::endl;
+}
+
+int main( int argc, char* argv[] )
+{
+    const std::size_t count{ (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 100000 };
+    const double gigabyte{ 1024.0 * 1024.0 * 1024.0 };
+
+    std::cout << "sizeof(Chip8State) = " << sizeof(Chip8State) << " bytes, "
+              << static_cast<std::size_t>(gigabyte / sizeof(Chip8State)) << " instances/GB" << std::endl;
+    std::cout << "sizeof(Chip8)      = " << sizeof(Chip8) << " bytes, "
+              << static_cast<std::size_t>(gigabyte / sizeof(Chip8)) << " instances/GB" << std::endl;
+
+    NullBus bus{};
+    {
+        std::vector<std::unique_ptr<Chip8>> cpus{};
+        cpus.reserve(count);
+
+        const Clock::time_point start{ Clock::now() };
+        for( std::size_t i{0}; i < count; ++i ) cpus.emplace_back(new Chip8(bus));
+        report("new Chip8            ", count, elapsedMs(start));
+    }
+
+    StatePool pool{};
+    std::vector<Chip8State*> states{};
+    states.reserve(count);
+    {
+        const Clock::time_point start{ Clock::now() };
+        for( std::size_t i{0}; i < count; ++i ) states.push_back(pool.acquire());
+        report("StatePool cold acquire", count, elapsedMs(start));
+    }
+
+    for( Chip8State *state : states ) pool.release(state);
+    states.clear();
+    {
+        const Clock::time_point start{ Clock::now() };
+        for( std::size_t i{0}; i < count; ++i ) states.push_back(pool.acquire());
+        report("StatePool warm acquire", count, elapsedMs(start));
+    }
+
+    {
+        const Clock::time_point start{ Clock::now() };
+        for( Chip8State *state : states ) pool.release(state);
+        report("StatePool release     ", count, elapsedMs(start));
+    }
+
+    std::cout << "pool capacity " << pool.capacity() << ", "
+              << (pool.capacity() * sizeof(Chip8State)) / (1024 * 1024) << " MB reserved" << std::endl;
+    return 0;
+}
@@ -0,0 +1,130 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Measures the row-delta stream for each ROM: bytes per message against the
+    8192 byte ARGB frame the window presents, the bandwidth of one viewer at
+    60 frames per second, and the time to encode a frame. Frames are encoded
+    as the emulator produces them, one message per changed frame.
+
+    Usage: bench_stream [rom files]
+*/
+
+#include <array>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+#include "chip8.hpp"
+#include "framebuffer.hpp"
+#include "random.hpp"
+#include "rowdelta.hpp"
+
+#define STREAM_FRAMES 20000
+#define RAW_FRAME_BYTES (WIDTH*HEIGHT*4)
+
+// Reads key 5 once every three frames, paced by the delay timer, and draws
+// a digit when it is held.
+const std::vector<uint8_t> PACED_ROM{
+    0x6B, 0x00, 0x60, 0x03, 0xF0, 0x15, 0xF1, 0x07,
+    0x31, 0x00, 0x12, 0x06, 0x62, 0x05, 0xE2, 0xA1,
+    0x12, 0x14, 0x12, 0x02, 0xF2, 0x29, 0xDB, 0x05,
+    0x7B, 0x05, 0x12, 0x02
+};
+
+class StreamBus : public Bus
+{
+    public:
+        Chip8 cpu;
+        Framebuffer framebuffer{};
+        Random random{1};
+
+        StreamBus(const std::vector<uint8_t>& rom) :
+            cpu(*this)
+        {
+            cpu.loadData(MEM_ADDR_START, rom.data(), static_cast<int>(rom.size()));
+        };
+
+        void notify(EventData event)
+        {
+            switch(event.type)
+            {
+                case EventType::DISPLAY_CLEAR:
+                    framebuffer.clearScreen(event.planes);
+                    break;
+                case EventType::DISPLAY_DRAW:
+                    cpu.setStatusReg(framebuffer.drawPixelData(event.draw.xpos, event.draw.ypos, event.draw.data,
+                        event.draw.size, event.draw.wrap, event.draw.wide, event.draw.planes));
+                    break;
+                case EventType::DISPLAY_SCROLL:
+                    framebuffer.scroll(event.scroll.dx, event.scroll.dy, event.scroll.planes);
+                    break;
+                case EventType::DISPLAY_MODE:
+                    framebuffer.setHires(event.hires);
+                    break;
+                case EventType::KEYBOARD_GET:
+                    // Key 5 held for a few frames out of every 16.
+                    *event.key = ((random.next() & 0xF) == 0) ? 0x5 : KEY_NOTPRESSED;
+                    break;
+                case EventType::RANDOM:
+                    *event.random.dest = event.random.mask & random.next();
+                    break;
+            }
+        };
+};
+
+void report(const std::string& name, const std::vector<uint8_t>& rom)
+{
+    StreamBus bus{rom};
+    RowDeltaEncoder encoder{};
+    std::array<uint8_t, STREAM_HEADER_SIZE> header{};
+    std::vector<uint8_t> payload{};
+    Planes planes{};
+
+    uint64_t messages{0}, bytes{0};
+    double encode_ms{0};
+    for( uint32_t frame{1}; frame <= STREAM_FRAMES; ++frame )
+    {
+        bus.cpu.cycle(INSTR_PER_FRAME);
+        bus.cpu.tickTimer();
+
+        for( std::size_t p{0}; p < PLANES; ++p ) planes[p] = bus.framebuffer.getPlane(p);
+
+        const Clock::time_point start{ Clock::now() };
+        const bool changed{ encoder.encode(planes, bus.framebuffer.isHires(), frame, header, payload) };
+        encode_ms += elapsedMs(start);
+
+        if( !changed ) continue;
+        ++messages;
+        bytes += STREAM_HEADER_SIZE + payload.size();
+    }
+
+    const double per_message{ (messages == 0) ? 0.0 : static_cast<double>(bytes) / messages };
+    const double per_second{ static_cast<double>(bytes) * 60 / STREAM_FRAMES };
+
+    std::cout << name << ": " << messages << "/" << STREAM_FRAMES << " frames changed, " << std::fixed
+              << std::setprecision(1) << per_message << " bytes/message ("
+              << per_message * 100 / RAW_FRAME_BYTES << "% of a " << RAW_FRAME_BYTES << " byte frame), "
+              << per_second / 1024 << " KiB/s per viewer at 60 fps (raw " << RAW_FRAME_BYTES * 60.0 / 1024
+              << "), encode " << std::setprecision(0) << encode_ms * 1e6 / STREAM_FRAMES << " ns/frame" << std::endl;
+}
+
+int main( int argc, char* argv[] )
+{
+    report("demo rom", DEMO_ROM);
+    report("timer paced rom", PACED_ROM);
+
+    for( int i{1}; i < argc; ++i )
+    {
+        const std::vector<uint8_t> rom{ readRom(argv[i]) };
+        if( rom.empty() )
+        {
+            std::cerr << "Could not read " << argv[i] << std::endl;
+            continue;
+        }
+        report(argv[i], rom);
+    }
+    return 0;
+}
@@ -0,0 +1,330 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Isolated microbenchmarks of the emulator's hot paths. Each benchmark runs
+    in batches sized to take at least BATCH_MIN_MS; after warmup batches the
+    time per operation of every repetition is collected and summarised as
+    median and percentiles. Results can be saved as JSON and compared against
+    a saved baseline, failing when a median regresses past the threshold.
+
+    Usage: chip8_microbench [--filter text] [--repetitions N] [--warmup N] [--cpu N]
+                            [--json out.json] [--baseline base.json] [--threshold 0.05]
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__linux__)
+#include <sched.h>
+#endif
+
+#include "bench.hpp"
+#include "chip8.hpp"
+#include "framebuffer.hpp"
+#include "keyboard.hpp"
+
+#define BATCH_MIN_MS 0.2
+
+// Keeps the compiler from discarding a value that is otherwise unused.
+template<typename T>
+inline void keep(const T& value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Routes events to a real framebuffer, like MainBus without SDL or globals.
+class BenchBus : public Bus
+{
+    public:
+        Chip8 cpu;
+        Framebuffer framebuffer{};
+
+        BenchBus() :
+            cpu(*this)
+        {};
+
+        void notify(EventData event)
+        {
+            switch(event.type)
+            {
+                case EventType::DISPLAY_CLEAR:
+                    framebuffer.clearScreen(event.planes);
+                    break;
+                case EventType::DISPLAY_DRAW:
+                    cpu.setStatusReg(framebuffer.drawPixelData(event.draw.xpos, event.draw.ypos, event.draw.data,
+                        event.draw.size, event.draw.wrap, event.draw.wide, event.draw.planes));
+                    break;
+                case EventType::DISPLAY_SCROLL:
+                    framebuffer.scroll(event.scroll.dx, event.scroll.dy, event.scroll.planes);
+                    break;
+                case EventType::DISPLAY_MODE:
+                    framebuffer.setHires(event.hires);
+                    break;
+                case EventType::KEYBOARD_GET:
+                    *event.key = KEY_NOTPRESSED;
+                    break;
+                case EventType::RANDOM:
+                    *event.random.dest = event.random.mask;
+                    break;
+            }
+        };
+};
+
+struct Result
+{
+    std::string name{};
+    std::size_t batch{};
+    std::vector<double> samples{};
+
+    double median{}, p10{}, p90{}, p99{}, min{}, mean{}, stddev{};
+};
+
+double percentile(const std::vector<double>& sorted, double p)
+{
+    const double rank{ p * (sorted.size() - 1) };
+    const std::size_t low{ static_cast<std::size_t>(rank) };
+    const std::size_t high{ std::min(low + 1, sorted.size() - 1) };
+    return sorted[low] + (sorted[high] - sorted[low]) * (rank - low);
+}
+
+void summarise(Result& result)
+{
+    std::vector<double> sorted{result.samples};
+    std::sort(sorted.begin(), sorted.end());
+
+    result.median = percentile(sorted, 0.5);
+    result.p10 = percentile(sorted, 0.1);
+    result.p90 = percentile(sorted, 0.9);
+    result.p99 = percentile(sorted, 0.99);
+    result.min = sorted.front();
+
+    double sum{0};
+    for( double sample : sorted ) sum += sample;
+    result.mean = sum / sorted.size();
+
+    double squares{0};
+    for( double sample : sorted ) squares += (sample - result.mean) * (sample - result.mean);
+    result.stddev = std::sqrt(squares / sorted.size());
+}
+
+// Runs body(iterations) in calibrated batches and records ns per iteration.
+Result measure(const std::string& name, const std::function<void(std::size_t)>& body,
+    std::size_t warmup, std::size_t repetitions)
+{
+    Result result{name};
+
+    result.batch = 1;
+    while( true )
+    {
+        const Clock::time_point start{ Clock::now() };
+        body(result.batch);
+        if( elapsedMs(start) >= BATCH_MIN_MS || result.batch >= (std::size_t{1} << 30) ) break;
+        result.batch *= 2;
+    }
+
+    for( std::size_t i{0}; i < warmup; ++i ) body(result.batch);
+
+    for( std::size_t i{0}; i < repetitions; ++i )
+    {
+        const Clock::time_point start{ Clock::now() };
+        body(result.batch);
+        result.samples.push_back(elapsedMs(start) * 1e6 / result.batch);
+    }
+
+    summarise(result);
+    return result;
+}
+
+bool pinToCpu(int cpu)
+{
+#ifdef _WIN32
+    return SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR{1} << cpu) != 0;
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+}
+
+void writeJson(const std::string& path, const std::vector<Result>& results)
+{
+    std::ofstream os{path};
+    os << std::setprecision(6) << "{\n  \"unit\": \"ns\",\n  \"benchmarks\": [\n";
+
+    for( std::size_t i{0}; i < results.size(); ++i )
+    {
+        const Result& r{ results[i] };
+        os << "    { \"name\": \"" << r.name << "\", \"batch\": " << r.batch << ", \"repetitions\": " << r.samples.size()
+           << ", \"median\": " << r.median << ", \"p10\": " << r.p10 << ", \"p90\": " << r.p90 << ", \"p99\": " << r.p99
+           << ", \"min\": " << r.min << ", \"mean\": " << r.mean << ", \"stddev\": " << r.stddev << " }"
+           << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    os << "  ]\n}\n";
+}
+
+// Reads back the medians of a file written by writeJson, one benchmark per line.
+std::map<std::string, double> readBaseline(const std::string& path)
+{
+    std::map<std::string, double> medians{};
+    std::ifstream is{path};
+
+    for( std::string line{}; std::getline(is, line); )
+    {
+        const std::size_t name{ line.find("\"name\": \"") };
+        const std::size_t median{ line.find("\"median\": ") };
+        if( name == std::string::npos || median == std::string::npos ) continue;
+
+        const std::size_t begin{ name + 9 };
+        medians[line.substr(begin, line.find('"', begin) - begin)] = std::strtod(line.c_str() + median + 10, nullptr);
+    }
+    return medians;
+}
+
+int main( int argc, char* argv[] )
+{
+    std::string filter{};
+    std::string json{};
+    std::string baseline{};
+    std::size_t repetitions{30};
+    std::size_t warmup{3};
+    double threshold{0.05};
+    int cpu{-1};
+
+    for( int i{1}; i < argc; ++i )
+    {
+        const bool has_value{ i + 1 < argc };
+
+        if( std::strcmp(argv[i], "--filter") == 0 && has_value ) filter = argv[++i];
+        else if( std::strcmp(argv[i], "--json") == 0 && has_value ) json = argv[++i];
+        else if( std::strcmp(argv[i], "--baseline") == 0 && has_value ) baseline = argv[++i];
+        else if( std::strcmp(argv[i], "--repetitions") == 0 && has_value ) repetitions = std::max<std::size_t>(std::strtoul(argv[++i], nullptr, 10), 1);
+        else if( std::strcmp(argv[i], "--warmup") == 0 && has_value ) warmup = std::strtoul(argv[++i], nullptr, 10);
+        else if( std::strcmp(argv[i], "--threshold") == 0 && has_value ) threshold = std::strtod(argv[++i], nullptr);
+        else if( std::strcmp(argv[i], "--cpu") == 0 && has_value ) cpu = std::atoi(argv[++i]);
+        else
+        {
+            std::cerr << "Unknown argument " << argv[i] << std::endl;
+            return 2;
+        }
+    }
+
+    if( cpu >= 0 && !pinToCpu(cpu) ) std::cerr << "Could not pin to cpu " << cpu << std::endl;
+
+    BenchBus bus{};
+    Chip8& chip8{ bus.cpu };
+    Framebuffer framebuffer{};
+    Keyboard keyboard{bus};
+
+    const uint8_t sprite[32]{ 0xF0, 0x90, 0xF0, 0x90, 0xF0, 0x3C, 0x42, 0x81, 0x81, 0x42, 0x3C, 0xFF, 0x00, 0xFF, 0x00, 0xFF,
+        0xF0, 0x90, 0xF0, 0x90, 0xF0, 0x3C, 0x42, 0x81, 0x81, 0x42, 0x3C, 0xFF, 0x00, 0xFF, 0x00, 0xFF };
+
+    // Runs the opcodes in turn through Chip8::execute, one per iteration.
+    auto executeLoop = [&chip8](std::vector<uint16_t> opcodes)
+    {
+        return [&chip8, opcodes](std::size_t n)
+        {
+            for( std::size_t i{0}; i < n; ++i ) chip8.execute(opcodes[i % opcodes.size()]);
+        };
+    };
+
+    std::vector<std::pair<std::string, std::function<void(std::size_t)>>> benchmarks{
+        { "chip8/fetch", [&chip8](std::size_t n) {
+            for( std::size_t i{0}; i < n; ++i ) keep(chip8.fetch());
+        } },
+        { "chip8/execute/alu_8xyn", executeLoop({ 0x8120, 0x8121, 0x8122, 0x8123, 0x8124, 0x8125, 0x8126, 0x8127, 0x812E }) },
+        { "chip8/execute/skips", executeLoop({ 0x3112, 0x4112, 0x5120, 0x9120 }) },
+        { "chip8/execute/dxyn", executeLoop({ 0xA000, 0xD125, 0xD125 }) },
+        { "chip8/execute/fx33", executeLoop({ 0xA300, 0xF133 }) },
+        { "chip8/execute/fx55", executeLoop({ 0xA300, 0xFF55 }) },
+        { "chip8/execute/fx65", executeLoop({ 0xA300, 0xFF65 }) },
+        { "framebuffer/clear", [&framebuffer](std::size_t n) {
+            for( std::size_t i{0}; i < n; ++i ) framebuffer.clearScreen();
+        } },
+        { "bus/notify", [&bus](std::size_t n) {
+            uint8_t key{};
+            Bus* base{&bus};
+            // Hides the dynamic type so the call stays virtual.
+            asm volatile("" : "+r"(base));
+            for( std::size_t i{0}; i < n; ++i ) base->notify({ .type = EventType::KEYBOARD_GET, .key = &key });
+            keep(key);
+        } },
+        { "keyboard/storeKey", [&keyboard](std::size_t n) {
+            for( std::size_t i{0}; i < n; ++i ) keyboard.storeKey((i & 1) ? SCANCODE_X : SCANCODE_1);
+        } }
+    };
+
+    // Sprite sizes in the middle of the screen, then the edge cases.
+    for( std::size_t size : { 1, 5, 15 } )
+    {
+        benchmarks.push_back({ "framebuffer/draw/rows_" + std::to_string(size), [&framebuffer, &sprite, size](std::size_t n) {
+            for( std::size_t i{0}; i < n; ++i ) keep(framebuffer.drawPixelData(20, 10, sprite, size));
+        } });
+    }
+    benchmarks.push_back({ "framebuffer/draw/clip_edge", [&framebuffer, &sprite](std::size_t n) {
+        for( std::size_t i{0}; i < n; ++i ) keep(framebuffer.drawPixelData(60, 28, sprite, 15));
+    } });
+    benchmarks.push_back({ "framebuffer/draw/wrap_edge", [&framebuffer, &sprite](std::size_t n) {
+        for( std::size_t i{0}; i < n; ++i ) keep(framebuffer.drawPixelData(60, 28, sprite, 15, true));
+    } });
+    benchmarks.push_back({ "framebuffer/draw/hires_16x16", [&sprite](std::size_t n) {
+        Framebuffer hires{};
+        hires.setHires(true);
+        for( std::size_t i{0}; i < n; ++i ) keep(hires.drawPixelData(56, 24, sprite, 16, false, true));
+    } });
+
+    std::vector<Result> results{};
+    for( const auto& benchmark : benchmarks )
+    {
+        if( !filter.empty() && benchmark.first.find(filter) == std::string::npos ) continue;
+
+        chip8.reset();
+        results.push_back(measure(benchmark.first, benchmark.second, warmup, repetitions));
+
+        const Result& r{ results.back() };
+        std::cout << std::left << std::setw(30) << r.name << std::right << std::fixed << std::setprecision(2)
+                  << " median " << std::setw(9) << r.median << " ns  p10 " << std::setw(9) << r.p10
+                  << "  p90 " << std::setw(9) << r.p90 << "  p99 " << std::setw(9) << r.p99
+                  << "  stddev " << std::setw(8) << r.stddev << std::endl;
+    }
+
+    if( !json.empty() ) writeJson(json, results);
+    if( baseline.empty() ) return 0;
+
+    const std::map<std::string, double> medians{ readBaseline(baseline) };
+    if( medians.empty() )
+    {
+        std::cerr << "Could not read baseline " << baseline << std::endl;
+        return 2;
+    }
+
+    int regressions{0};
+    for( const Result& r : results )
+    {
+        const auto found{ medians.find(r.name) };
+        if( found == medians.end() ) continue;
+
+        const double change{ r.median / found->second - 1 };
+        const char* verdict{ change > threshold ? "REGRESSED" : (change < -threshold ? "improved" : "same") };
+        regressions += change > threshold;
+
+        std::cout << std::left << std::setw(30) << r.name << std::right << std::showpos << std::setw(8)
+                  << change * 100 << std::noshowpos << "%  " << verdict << std::endl;
+    }
+    return regressions > 0 ? 1 : 0;
+}
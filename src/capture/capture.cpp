@@ -0,0 +1,215 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Defines the frame capture and its writer thread.
+    Y4M layout from https://wiki.multimedia.cx/index.php/YUV4MPEG2 and PPM
+    from https://netpbm.sourceforge.net/doc/ppm.html
+*/
+
+#include <algorithm>
+#include <chrono>
+
+#include "capture.hpp"
+
+SlotQueue::SlotQueue(std::size_t capacity) :
+    slots(capacity + 1)
+{};
+
+bool SlotQueue::push(uint32_t slot)
+{
+    const std::size_t t{ tail.load(std::memory_order_relaxed) };
+    const std::size_t next{ (t + 1) % slots.size() };
+    if( next == head.load(std::memory_order_acquire) ) return false;
+
+    slots[t] = slot;
+    tail.store(next, std::memory_order_release);
+    return true;
+};
+
+bool SlotQueue::pop(uint32_t& slot)
+{
+    const std::size_t h{ head.load(std::memory_order_relaxed) };
+    if( h == tail.load(std::memory_order_acquire) ) return false;
+
+    slot = slots[h];
+    head.store((h + 1) % slots.size(), std::memory_order_release);
+    return true;
+};
+
+std::size_t SlotQueue::size() const
+{
+    const std::size_t h{ head.load(std::memory_order_acquire) };
+    const std::size_t t{ tail.load(std::memory_order_acquire) };
+    return (t + slots.size() - h) % slots.size();
+};
+
+Capture::Capture(const std::string& path, std::size_t scale, const std::array<uint32_t, COLOURS>& palette,
+    std::size_t depth) :
+    format( (path.size() >= 4 && path.compare(path.size() - 4, 4, ".y4m") == 0) ? CaptureFormat::Y4M : CaptureFormat::PPM ),
+    scale( std::max<std::size_t>(scale, 1) ),
+    out_width( HIRES_WIDTH * this->scale ),
+    out_height( HIRES_HEIGHT * this->scale ),
+    palette(palette),
+    frames(depth),
+    free_slots(depth),
+    ready_slots(depth),
+    out(path, std::ios_base::out | std::ios_base::binary)
+{
+    for( std::size_t c{0}; c < COLOURS; ++c )
+    {
+        const uint32_t r{ (palette[c] >> 16) & 0xFF }, g{ (palette[c] >> 8) & 0xFF }, b{ palette[c] & 0xFF };
+        luma[c] = static_cast<uint8_t>((77*r + 150*g + 29*b) >> 8);
+    }
+
+    for( std::size_t b{0}; b < spread.size(); ++b )
+    {
+        for( std::size_t k{0}; k < 8; ++k ) spread[b] |= static_cast<uint64_t>((b >> (7 - k)) & 1) << (8*k);
+    }
+
+    for( uint32_t slot{0}; slot < depth; ++slot ) free_slots.push(slot);
+
+    row_buffer.resize(out_width * (format == CaptureFormat::PPM ? 3 : 1));
+
+    if( !out.good() ) return;
+
+    if( format == CaptureFormat::Y4M )
+    {
+        out << "YUV4MPEG2 W" << out_width << " H" << out_height << " F" << CAPTURE_FPS << ":1 Ip A1:1 Cmono\n";
+    }
+
+    writer = std::thread{ &Capture::writerLoop, this };
+};
+
+Capture::~Capture()
+{
+    close();
+};
+
+bool Capture::isOpen() const
+{
+    return writer.joinable();
+};
+
+bool Capture::submit(const Framebuffer& framebuffer)
+{
+    if( !isOpen() ) return false;
+
+    submitted.fetch_add(1, std::memory_order_relaxed);
+
+    uint32_t slot{};
+    if( !free_slots.pop(slot) )
+    {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    Frame& frame{ frames[slot] };
+    for( std::size_t p{0}; p < PLANES; ++p ) frame.planes[p] = framebuffer.getPlane(p);
+    frame.hires = framebuffer.isHires();
+
+    // Never fails, there are only as many slots as the queue holds.
+    ready_slots.push(slot);
+
+    const std::size_t depth{ ready_slots.size() };
+    if( depth > max_queue_depth.load(std::memory_order_relaxed) ) max_queue_depth.store(depth, std::memory_order_relaxed);
+
+    ready_cv.notify_one();
+    return true;
+};
+
+void Capture::close()
+{
+    if( !isOpen() ) return;
+
+    stopping.store(true, std::memory_order_release);
+    ready_cv.notify_one();
+    writer.join();
+
+    out.close();
+};
+
+CaptureStats Capture::stats() const
+{
+    return {
+        .submitted = submitted.load(std::memory_order_relaxed),
+        .written = written.load(std::memory_order_relaxed),
+        .dropped = dropped.load(std::memory_order_relaxed),
+        .queue_depth = ready_slots.size(),
+        .max_queue_depth = max_queue_depth.load(std::memory_order_relaxed)
+    };
+};
+
+void Capture::writerLoop()
+{
+    while( true )
+    {
+        // Read before popping: once stopping is seen every frame is queued.
+        const bool stop{ stopping.load(std::memory_order_acquire) };
+
+        uint32_t slot{};
+        if( ready_slots.pop(slot) )
+        {
+            writeFrame(frames[slot]);
+            free_slots.push(slot);
+            written.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        if( stop ) break;
+
+        // Submitters notify without taking the lock, so a wakeup can be
+        // missed; the timeout bounds how long that delays the writer.
+        std::unique_lock<std::mutex> lock{mutex};
+        ready_cv.wait_for(lock, std::chrono::milliseconds(2));
+    }
+
+    out.flush();
+};
+
+void Capture::writeFrame(const Frame& frame)
+{
+    const std::size_t factor{ frame.hires ? scale : 2*scale };
+    const std::size_t rows{ static_cast<std::size_t>(frame.hires ? HIRES_HEIGHT : HEIGHT) };
+    const std::size_t words{ frame.hires ? ROW_WORDS : 1u };
+
+    if( format == CaptureFormat::Y4M ) out << "FRAME\n";
+    else out << "P6\n" << out_width << " " << out_height << "\n255\n";
+
+    for( std::size_t y{0}; y < rows; ++y )
+    {
+        uint8_t* dest{ row_buffer.data() };
+
+        for( std::size_t w{0}; w < words; ++w )
+        {
+            for( int shift{56}; shift >= 0; shift -= 8 )
+            {
+                // Eight colour indices at once, one per byte.
+                uint64_t colours{0};
+                for( std::size_t p{0}; p < PLANES; ++p )
+                {
+                    colours |= spread[(frame.planes[p][w][y] >> shift) & 0xFF] << p;
+                }
+
+                for( std::size_t k{0}; k < 8; ++k )
+                {
+                    const std::size_t c{ (colours >> (8*k)) & 0xFF };
+                    if( format == CaptureFormat::Y4M )
+                    {
+                        dest = std::fill_n(dest, factor, luma[c]);
+                        continue;
+                    }
+
+                    const uint8_t rgb[3]{ static_cast<uint8_t>(palette[c] >> 16), static_cast<uint8_t>(palette[c] >> 8),
+                        static_cast<uint8_t>(palette[c]) };
+                    for( std::size_t i{0}; i < factor; ++i ) dest = std::copy(std::begin( rgb ), std::end( rgb ), dest);
+                }
+            }
+        }
+
+        for( std::size_t i{0}; i < factor; ++i )
+        {
+            out.write(reinterpret_cast<const char *>(row_buffer.data()), static_cast<std::streamsize>(row_buffer.size()));
+        }
+    }
+};
@@ -0,0 +1,131 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Declares the frame capture. The emulation thread copies the bit packed
+    framebuffer into a slot taken from a fixed pool and hands it over through
+    a single producer, single consumer queue; a background thread expands the
+    slots into an uncompressed Y4M or PPM stream. Submitting never waits on
+    the writer: when every slot is still queued the frame is dropped and
+    counted instead.
+*/
+
+#ifndef CAPTURE_H
+#define CAPTURE_H
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "header.hpp"
+#include "framebuffer.hpp"
+
+#define CAPTURE_FPS 60
+#define CAPTURE_DEPTH 64
+
+enum class CaptureFormat
+{
+    Y4M,
+    PPM
+};
+
+struct CaptureStats
+{
+    uint64_t submitted{};
+    uint64_t written{};
+    uint64_t dropped{};
+    std::size_t queue_depth{};
+    std::size_t max_queue_depth{};
+};
+
+// Fixed capacity ring of slot indices, safe for one pushing and one popping thread.
+class SlotQueue
+{
+    private:
+        std::vector<uint32_t> slots{};
+        alignas(64) std::atomic<std::size_t> head{0};
+        alignas(64) std::atomic<std::size_t> tail{0};
+
+    public:
+        SlotQueue(std::size_t capacity);
+
+        bool push(uint32_t slot);
+        bool pop(uint32_t& slot);
+        std::size_t size() const;
+};
+
+class Capture
+{
+    private:
+        struct Frame
+        {
+            std::array<Framebuffer::Plane, PLANES> planes{};
+            bool hires{};
+        };
+
+        CaptureFormat format{};
+        std::size_t scale{};
+
+        // Frames are always HIRES_WIDTH x HIRES_HEIGHT times scale, so lores
+        // pixels are written twice as wide and tall.
+        std::size_t out_width{};
+        std::size_t out_height{};
+
+        std::array<uint32_t, COLOURS> palette{};
+        std::array<uint8_t, COLOURS> luma{};
+
+        // spread[b] holds the eight bits of b as eight 0/1 bytes, leftmost first.
+        std::array<uint64_t, 256> spread{};
+
+        std::vector<Frame> frames{};
+        SlotQueue free_slots;
+        SlotQueue ready_slots;
+
+        std::atomic<uint64_t> submitted{0};
+        std::atomic<uint64_t> written{0};
+        std::atomic<uint64_t> dropped{0};
+        std::atomic<std::size_t> max_queue_depth{0};
+
+        std::ofstream out{};
+        std::vector<uint8_t> row_buffer{};
+
+        std::mutex mutex{};
+        std::condition_variable ready_cv{};
+        std::atomic<bool> stopping{false};
+        std::thread writer{};
+
+        void writerLoop();
+        void writeFrame(const Frame& frame);
+
+    public:
+        // The format follows the extension: ".y4m" streams Y4M, anything else
+        // a sequence of binary PPM images. The palette is the ARGB colour of
+        // each colour index, see Framebuffer::render.
+        Capture(const std::string& path, std::size_t scale = 1,
+            const std::array<uint32_t, COLOURS>& palette = {0x00000000, 0xFFFFFFFF, 0xFFAAAAAA, 0xFF555555},
+            std::size_t depth = CAPTURE_DEPTH);
+        ~Capture();
+
+        Capture(const Capture&) = delete;
+        Capture& operator=(const Capture&) = delete;
+
+        bool isOpen() const;
+
+        // Queues a copy of the framebuffer. Returns false if the frame was
+        // dropped because the writer has fallen depth frames behind.
+        bool submit(const Framebuffer& framebuffer);
+
+        // Writes every queued frame and stops the writer thread.
+        void close();
+
+        CaptureStats stats() const;
+};
+
+#endif
@@ -0,0 +1,99 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Entry point of the static analyzer. Prints the control-flow graph of a ROM
+    as Graphviz DOT or JSON, or a summary of what the analysis found.
+
+    Usage: chip8_analyze [--format summary|dot|json] [--profile auto|name] rom
+
+    --profile auto, the default, picks the profile the reachable opcodes call for.
+*/
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "analyzer.hpp"
+
+void printSummary(const ProgramAnalysis& analysis)
+{
+    std::size_t code{0}, sprites{0};
+    for( ByteKind kind : analysis.kinds )
+    {
+        code += kind == ByteKind::CODE;
+        sprites += kind == ByteKind::SPRITE;
+    }
+
+    std::cout << "profile " << profileName(analysis.profile) << ", " << analysis.rom_size << " bytes: " << code
+              << " code, " << sprites << " sprite data, " << analysis.rom_size - std::min(analysis.rom_size, code + sprites)
+              << " unknown" << std::endl;
+    std::cout << analysis.instructions.size() << " instructions in " << analysis.blocks.size() << " blocks, "
+              << analysis.indirect_jumps.size() << " indirect jumps" << std::endl;
+
+    for( const IndirectJump& jump : analysis.indirect_jumps )
+    {
+        std::cout << "  " << std::hex << jump.addr << std::dec << ": ";
+        if( jump.targets.empty() ) std::cout << "unresolved";
+        else std::cout << jump.targets.size() << " targets";
+        std::cout << std::endl;
+    }
+
+    std::cout << analysis.write_targets.count() << " bytes written by FX55/FX33, " << analysis.unresolved_writes
+              << " writes through an unknown I" << std::endl;
+    for( const AddressRange& range : analysis.self_modifying )
+    {
+        std::cout << "  self-modifying " << std::hex << range.start << "-" << range.end << std::dec << std::endl;
+    }
+
+    std::cout << analysis.loops.size() << " loops" << std::endl;
+    for( const ProgramLoop& loop : analysis.loops )
+    {
+        std::cout << "  " << std::hex << loop.head << "-" << loop.tail << std::dec << " " << loop.instructions
+                  << " instructions" << ((loop.flags & LOOP_HOT) ? ", hot" : "") << ((loop.flags & LOOP_DRAWS) ? ", draws" : "")
+                  << ((loop.flags & LOOP_READS_KEYS) ? ", reads keys" : "") << ((loop.flags & LOOP_POLLS_TIMER) ? ", polls timer" : "")
+                  << ((loop.flags & LOOP_WAITS_KEY) ? ", waits for a key" : "") << ((loop.flags & LOOP_HALTS) ? ", halts" : "")
+                  << ((loop.flags & LOOP_SELF_MODIFYING) ? ", self-modifying" : "") << std::endl;
+    }
+}
+
+int main( int argc, char* argv[] )
+{
+    std::string format{"summary"};
+    std::string profile_name{"auto"};
+    const char* rom_path{nullptr};
+
+    for( int i{1}; i < argc; ++i )
+    {
+        if( std::strcmp(argv[i], "--format") == 0 && i + 1 < argc ) format = argv[++i];
+        else if( std::strcmp(argv[i], "--profile") == 0 && i + 1 < argc ) profile_name = argv[++i];
+        else rom_path = argv[i];
+    }
+
+    Profile profile{};
+    if( rom_path == nullptr || (format != "summary" && format != "dot" && format != "json")
+        || (profile_name != "auto" && !profileFromName(profile_name, profile)) )
+    {
+        std::cerr << "Usage: chip8_analyze [--format summary|dot|json] [--profile auto|name] rom" << std::endl;
+        return 2;
+    }
+
+    std::ifstream is{rom_path, std::ios_base::in | std::ios_base::binary};
+    if( !is.good() )
+    {
+        std::cerr << "Could not read " << rom_path << std::endl;
+        return 1;
+    }
+    const std::vector<uint8_t> rom{ std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>() };
+
+    if( profile_name == "auto" ) profile = detectProfile(rom.data(), rom.size());
+    const ProgramAnalysis analysis{ analyzeProgram(rom.data(), rom.size(), profile) };
+
+    if( format == "dot" ) writeDot(analysis, std::cout);
+    else if( format == "json" ) writeJson(analysis, std::cout);
+    else printSummary(analysis);
+    return 0;
+}
@@ -0,0 +1,796 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Defines the static ROM analyzer.
+*/
+
+#include <algorithm>
+#include <cstdio>
+#include <map>
+
+#include "analyzer.hpp"
+#include "header.hpp"
+
+// Per address marks of the walk.
+#define MARK_INSTR 0x01
+#define MARK_LEADER 0x02
+
+// Longest BNNN jump table followed when the register is unknown.
+#define JUMP_TABLE_LIMIT 128
+
+struct QuirkFlags
+{
+    bool jump_uses_vx{};
+    IndexIncrement load_store{};
+    bool logic_resets_vf{};
+    bool schip_opcodes{};
+    bool xochip_opcodes{};
+};
+
+template<typename Quirks>
+static QuirkFlags flagsOf()
+{
+    return { Quirks::jump_uses_vx, Quirks::load_store, Quirks::logic_resets_vf, Quirks::schip_opcodes,
+        Quirks::xochip_opcodes };
+}
+
+static QuirkFlags quirkFlags(Profile profile)
+{
+    switch(profile)
+    {
+        case Profile::COSMAC_VIP:   return flagsOf<quirks::CosmacVip>();
+        case Profile::CHIP_48:      return flagsOf<quirks::Chip48>();
+        case Profile::SUPER_CHIP:   return flagsOf<quirks::SuperChip>();
+        case Profile::XO_CHIP:      return flagsOf<quirks::XoChip>();
+        default:                    return flagsOf<quirks::Default>();
+    }
+}
+
+// What the constant propagation knows on entry to a block.
+struct Constants
+{
+    int32_t reg[16]{};
+    int32_t index{};
+    int32_t planes{1};
+    bool reached{};
+};
+
+static Constants unknownConstants()
+{
+    Constants constants{ .index = UNKNOWN_VALUE, .planes = UNKNOWN_VALUE, .reached = true };
+    std::fill_n(constants.reg, 16, UNKNOWN_VALUE);
+    return constants;
+}
+
+// Widens into to cover from, returns true if into changed.
+static bool merge(Constants& into, const Constants& from)
+{
+    if( !into.reached )
+    {
+        into = from;
+        return true;
+    }
+
+    bool changed{false};
+    auto widen = [&](int32_t& value, int32_t other)
+    {
+        if( value == other || value == UNKNOWN_VALUE ) return;
+        value = UNKNOWN_VALUE;
+        changed = true;
+    };
+
+    for( std::size_t i{0}; i < 16; ++i ) widen(into.reg[i], from.reg[i]);
+    widen(into.index, from.index);
+    widen(into.planes, from.planes);
+    return changed;
+}
+
+static void advanceIndex(Constants& constants, std::size_t x, IndexIncrement increment)
+{
+    if( constants.index == UNKNOWN_VALUE || increment == IndexIncrement::NONE ) return;
+    constants.index = (constants.index + static_cast<int32_t>(x) + (increment == IndexIncrement::X_PLUS_ONE)) & 0xFFFF;
+}
+
+// The effect of one instruction on what is known, following Chip8::executeAs.
+static void transfer(uint16_t opcode, Constants& constants, const QuirkFlags& quirks)
+{
+    const std::size_t x{ static_cast<std::size_t>((opcode >> 8) & 0xF) };
+    const std::size_t y{ static_cast<std::size_t>((opcode >> 4) & 0xF) };
+    const int32_t nn{ opcode & 0xFF };
+    int32_t* reg{ constants.reg };
+
+    switch( opcode >> 12 )
+    {
+        case 0x6:
+            reg[x] = nn;
+            break;
+        case 0x7:
+            if( reg[x] != UNKNOWN_VALUE ) reg[x] = (reg[x] + nn) & 0xFF;
+            break;
+        case 0x8:
+        {
+            const bool known{ reg[x] != UNKNOWN_VALUE && reg[y] != UNKNOWN_VALUE };
+            switch( opcode & 0xF )
+            {
+                case 0x0:
+                    reg[x] = reg[y];
+                    break;
+                case 0x1:
+                    reg[x] = known ? (reg[x] | reg[y]) : UNKNOWN_VALUE;
+                    if( quirks.logic_resets_vf ) reg[0xF] = 0;
+                    break;
+                case 0x2:
+                    reg[x] = known ? (reg[x] & reg[y]) : UNKNOWN_VALUE;
+                    if( quirks.logic_resets_vf ) reg[0xF] = 0;
+                    break;
+                case 0x3:
+                    reg[x] = known ? (reg[x] ^ reg[y]) : UNKNOWN_VALUE;
+                    if( quirks.logic_resets_vf ) reg[0xF] = 0;
+                    break;
+                case 0x4:
+                case 0x5:
+                case 0x6:
+                case 0x7:
+                case 0xE:
+                    reg[x] = UNKNOWN_VALUE;
+                    reg[0xF] = UNKNOWN_VALUE;
+                    break;
+            }
+            break;
+        }
+        case 0xA:
+            constants.index = opcode & 0x0FFF;
+            break;
+        case 0xC:
+            reg[x] = UNKNOWN_VALUE;
+            break;
+        case 0xD:
+            reg[0xF] = UNKNOWN_VALUE;
+            break;
+        case 0xF:
+            switch( nn )
+            {
+                case 0x01:
+                    if( quirks.xochip_opcodes ) constants.planes = static_cast<int32_t>(x & ((1 << PLANES) - 1));
+                    break;
+                case 0x07:
+                case 0x0A:
+                    reg[x] = UNKNOWN_VALUE;
+                    break;
+                case 0x1E:
+                    constants.index = (constants.index == UNKNOWN_VALUE || reg[x] == UNKNOWN_VALUE)
+                        ? UNKNOWN_VALUE : (constants.index + reg[x]) & 0xFFFF;
+                    break;
+                case 0x29:
+                    constants.index = (reg[x] == UNKNOWN_VALUE) ? UNKNOWN_VALUE : ADDR_SPRITE + reg[x]*5;
+                    break;
+                case 0x30:
+                    if( quirks.schip_opcodes )
+                    {
+                        constants.index = (reg[x] == UNKNOWN_VALUE) ? UNKNOWN_VALUE : ADDR_BIG_SPRITE + (reg[x] & 0xF)*10;
+                    }
+                    break;
+                case 0x55:
+                    advanceIndex(constants, x, quirks.load_store);
+                    break;
+                case 0x65:
+                    std::fill_n(reg, x + 1, UNKNOWN_VALUE);
+                    advanceIndex(constants, x, quirks.load_store);
+                    break;
+                case 0x85:
+                    if( quirks.schip_opcodes ) std::fill_n(reg, x + 1, UNKNOWN_VALUE);
+                    break;
+            }
+            break;
+    }
+}
+
+static bool isSkip(uint16_t opcode)
+{
+    switch( opcode >> 12 )
+    {
+        case 0x3:
+        case 0x4:
+        case 0x5:
+        case 0x9:
+            return true;
+        case 0xE:
+            return (opcode & 0xFF) == 0x9E || (opcode & 0xFF) == 0xA1;
+    }
+    return false;
+}
+
+// Returns true if the instruction ends its block, with its successors in edges.
+static bool controlFlow(uint16_t addr, uint16_t opcode, const QuirkFlags& quirks,
+    const std::map<uint16_t, std::vector<uint16_t>>& indirect, std::vector<CfgEdge>& edges)
+{
+    edges.clear();
+    const uint16_t next{ static_cast<uint16_t>(addr + 2) };
+    const uint16_t nnn{ static_cast<uint16_t>(opcode & 0x0FFF) };
+
+    if( isSkip(opcode) )
+    {
+        edges.push_back({ next, EdgeKind::FALLTHROUGH });
+        edges.push_back({ static_cast<uint16_t>(next + 2), EdgeKind::SKIP });
+        return true;
+    }
+
+    switch( opcode >> 12 )
+    {
+        case 0x0:
+            return opcode == 0x00EE || (quirks.schip_opcodes && opcode == 0x00FD);
+        case 0x1:
+            edges.push_back({ nnn, EdgeKind::JUMP });
+            return true;
+        case 0x2:
+            edges.push_back({ nnn, EdgeKind::CALL });
+            edges.push_back({ next, EdgeKind::RETURN_SITE });
+            return true;
+        case 0xB:
+        {
+            auto found{ indirect.find(addr) };
+            if( found != indirect.end() )
+            {
+                for( uint16_t target : found->second ) edges.push_back({ target, EdgeKind::INDIRECT });
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool usesSuperChip(uint16_t opcode)
+{
+    if( (opcode & 0xFFF0) == 0x00C0 || (opcode >= 0x00FB && opcode <= 0x00FF) ) return true;
+    if( (opcode & 0xF00F) == 0xD000 ) return true;
+
+    const uint16_t low{ static_cast<uint16_t>(opcode & 0xF0FF) };
+    return low == 0xF030 || low == 0xF075 || low == 0xF085;
+}
+
+static bool usesXoChip(uint16_t opcode)
+{
+    return (opcode & 0xFFF0) == 0x00D0 || (opcode & 0xF0FF) == 0xF001;
+}
+
+static uint8_t loopFlag(uint16_t opcode)
+{
+    if( (opcode >> 12) == 0xD ) return LOOP_DRAWS;
+    if( isSkip(opcode) && (opcode >> 12) == 0xE ) return LOOP_READS_KEYS;
+    if( (opcode >> 12) == 0x2 ) return LOOP_CALLS;
+    if( (opcode & 0xF0FF) == 0xF007 ) return LOOP_POLLS_TIMER;
+    if( (opcode & 0xF0FF) == 0xF00A ) return LOOP_WAITS_KEY;
+    return 0;
+}
+
+const CfgBlock* ProgramAnalysis::blockAt(uint16_t addr) const
+{
+    auto found{ std::lower_bound(blocks.begin(), blocks.end(), addr,
+        [](const CfgBlock& block, uint16_t start) { return block.start < start; }) };
+    return (found != blocks.end() && found->start == addr) ? &*found : nullptr;
+};
+
+ProgramAnalysis analyzeProgram(const uint8_t rom[], std::size_t size, Profile profile)
+{
+    ProgramAnalysis analysis{ .profile = profile, .rom_size = size };
+    const QuirkFlags quirks{ quirkFlags(profile) };
+
+    const std::size_t limit{ MEM_ADDR_START + std::min<std::size_t>(size, ROM_MAX_SIZE) };
+    auto inCode = [&](std::size_t addr) { return addr >= MEM_ADDR_START && addr + 1 < limit; };
+    auto opcodeAt = [&](std::size_t addr) -> uint16_t
+    {
+        return static_cast<uint16_t>((rom[addr - MEM_ADDR_START] << 8) | rom[addr + 1 - MEM_ADDR_START]);
+    };
+
+    std::vector<uint8_t> marks(MEM_SIZE, 0);
+    std::vector<uint16_t> pending{ MEM_ADDR_START };
+    marks[MEM_ADDR_START] |= MARK_LEADER;
+
+    auto follow = [&](uint16_t target)
+    {
+        if( target >= MEM_SIZE ) return;
+        marks[target] |= MARK_LEADER;
+        pending.push_back(target);
+    };
+
+    std::map<uint16_t, std::vector<uint16_t>> indirect{};
+    std::vector<int32_t> block_at(MEM_SIZE, -1);
+    std::vector<Constants> entry{};
+    std::vector<CfgEdge> edges{};
+
+    // Discovery and constant propagation repeat until no BNNN gains a target.
+    bool grew{true};
+    while( grew )
+    {
+        while( !pending.empty() )
+        {
+            std::size_t addr{ pending.back() };
+            pending.pop_back();
+
+            for( ; inCode(addr) && !(marks[addr] & MARK_INSTR); addr += 2 )
+            {
+                marks[addr] |= MARK_INSTR;
+                if( !controlFlow(static_cast<uint16_t>(addr), opcodeAt(addr), quirks, indirect, edges) ) continue;
+
+                for( const CfgEdge& edge : edges ) follow(edge.target);
+                break;
+            }
+        }
+
+        // A block runs until an instruction ends it or the next one starts another.
+        analysis.blocks.clear();
+        std::fill(block_at.begin(), block_at.end(), -1);
+        for( std::size_t addr{MEM_ADDR_START}; addr < limit; )
+        {
+            if( !(marks[addr] & MARK_INSTR) )
+            {
+                ++addr;
+                continue;
+            }
+
+            CfgBlock block{ .start = static_cast<uint16_t>(addr) };
+            while( true )
+            {
+                const std::size_t next{ addr + 2 };
+                if( controlFlow(static_cast<uint16_t>(addr), opcodeAt(addr), quirks, indirect, edges) )
+                {
+                    block.successors = edges;
+                    addr = next;
+                    break;
+                }
+
+                addr = next;
+                if( !inCode(next) || !(marks[next] & MARK_INSTR) ) break;
+                if( marks[next] & MARK_LEADER )
+                {
+                    block.successors.push_back({ static_cast<uint16_t>(next), EdgeKind::FALLTHROUGH });
+                    break;
+                }
+            }
+            block.end = static_cast<uint16_t>(addr);
+
+            block_at[block.start] = static_cast<int32_t>(analysis.blocks.size());
+            analysis.blocks.push_back(block);
+        }
+
+        // Registers, I and the plane mask start out as reset leaves them.
+        entry.assign(analysis.blocks.size(), Constants{});
+        std::vector<std::size_t> work{};
+        if( block_at[MEM_ADDR_START] >= 0 )
+        {
+            entry[block_at[MEM_ADDR_START]].reached = true;
+            work.push_back(block_at[MEM_ADDR_START]);
+        }
+
+        while( !work.empty() )
+        {
+            const CfgBlock& block{ analysis.blocks[work.back()] };
+            Constants constants{ entry[work.back()] };
+            work.pop_back();
+
+            for( std::size_t addr{block.start}; addr < block.end; addr += 2 ) transfer(opcodeAt(addr), constants, quirks);
+
+            for( const CfgEdge& edge : block.successors )
+            {
+                if( edge.target >= MEM_SIZE ) continue;
+                const int32_t target{ block_at[edge.target] };
+                if( target < 0 ) continue;
+
+                // Nothing is known about what a subroutine leaves behind.
+                const Constants& out{ (edge.kind == EdgeKind::RETURN_SITE) ? unknownConstants() : constants };
+                if( merge(entry[target], out) ) work.push_back(static_cast<std::size_t>(target));
+            }
+        }
+
+        // BNNN goes to NNN plus the register if it is known, otherwise to
+        // every entry of a table of jumps at NNN. Targets only accumulate,
+        // so this ends.
+        grew = false;
+        for( std::size_t b{0}; b < analysis.blocks.size(); ++b )
+        {
+            const CfgBlock& block{ analysis.blocks[b] };
+            const uint16_t last{ static_cast<uint16_t>(block.end - 2) };
+            const uint16_t opcode{ opcodeAt(last) };
+            if( (opcode >> 12) != 0xB ) continue;
+
+            Constants constants{ entry[b].reached ? entry[b] : unknownConstants() };
+            for( std::size_t addr{block.start}; addr < last; addr += 2 ) transfer(opcodeAt(addr), constants, quirks);
+
+            const uint16_t base{ static_cast<uint16_t>(opcode & 0x0FFF) };
+            const int32_t offset{ constants.reg[quirks.jump_uses_vx ? (opcode >> 8) & 0xF : 0] };
+
+            std::vector<uint16_t> targets{};
+            if( offset != UNKNOWN_VALUE ) targets.push_back(static_cast<uint16_t>(base + offset));
+            else
+            {
+                for( std::size_t addr{base}; inCode(addr) && (opcodeAt(addr) >> 12) == 0x1
+                    && targets.size() < JUMP_TABLE_LIMIT; addr += 2 )
+                {
+                    targets.push_back(static_cast<uint16_t>(addr));
+                }
+            }
+
+            std::vector<uint16_t>& known{ indirect[last] };
+            for( uint16_t target : targets )
+            {
+                if( std::find(known.begin(), known.end(), target) != known.end() ) continue;
+
+                known.push_back(target);
+                follow(target);
+                grew = true;
+            }
+        }
+    }
+
+    for( const auto& [addr, targets] : indirect ) analysis.indirect_jumps.push_back({ addr, targets });
+    for( IndirectJump& jump : analysis.indirect_jumps ) std::sort(jump.targets.begin(), jump.targets.end());
+
+    for( std::size_t addr{MEM_ADDR_START}; addr < limit; ++addr )
+    {
+        if( !(marks[addr] & MARK_INSTR) ) continue;
+        analysis.kinds[addr] = ByteKind::CODE;
+        analysis.kinds[addr + 1] = ByteKind::CODE;
+    }
+
+    // Replays each block from its entry constants to place what it reads and writes.
+    for( std::size_t b{0}; b < analysis.blocks.size(); ++b )
+    {
+        const CfgBlock& block{ analysis.blocks[b] };
+        Constants constants{ entry[b].reached ? entry[b] : unknownConstants() };
+
+        for( std::size_t addr{block.start}; addr < block.end; addr += 2 )
+        {
+            const uint16_t opcode{ opcodeAt(addr) };
+            const std::size_t x{ static_cast<std::size_t>((opcode >> 8) & 0xF) };
+            const int32_t index{ constants.index };
+
+            analysis.instructions.push_back({ static_cast<uint16_t>(addr), opcode, index });
+            analysis.uses_schip |= usesSuperChip(opcode);
+            analysis.uses_xochip |= usesXoChip(opcode);
+
+            std::size_t read{0}, written{0};
+            if( (opcode >> 12) == 0xD )
+            {
+                const bool wide{ quirks.schip_opcodes && (opcode & 0xF) == 0 };
+                const std::size_t rows{ wide ? 16u : static_cast<std::size_t>(opcode & 0xF) };
+                const int32_t planes{ (constants.planes == UNKNOWN_VALUE) ? 1 : constants.planes };
+                read = rows * (wide ? 2 : 1) * static_cast<std::size_t>(__builtin_popcount(planes));
+            }
+            else if( (opcode & 0xF0FF) == 0xF033 ) written = 3;
+            else if( (opcode & 0xF0FF) == 0xF055 ) written = x + 1;
+
+            if( (read > 0 || written > 0) && index == UNKNOWN_VALUE ) analysis.unresolved_writes += written > 0;
+            else
+            {
+                // The interpreter masks every address, so accesses past 0xFFF,
+                // or with I above it, land at the start of memory.
+                for( std::size_t i{0}; i < read; ++i )
+                {
+                    const std::size_t addr{ (index + i) & MEM_MASK };
+                    if( analysis.kinds[addr] != ByteKind::CODE ) analysis.kinds[addr] = ByteKind::SPRITE;
+                }
+                for( std::size_t i{0}; i < written; ++i ) analysis.write_targets.set((index + i) & MEM_MASK);
+            }
+
+            transfer(opcode, constants, quirks);
+        }
+    }
+
+    // A store through an unknown I may land on any instruction, so then
+    // every code byte counts as possibly overwritten and no loop is hot.
+    const bool writes_anywhere{ analysis.unresolved_writes > 0 };
+    std::bitset<MEM_SIZE> modified{};
+    for( std::size_t addr{0}; addr < MEM_SIZE; ++addr )
+    {
+        modified[addr] = (writes_anywhere || analysis.write_targets[addr]) && analysis.kinds[addr] == ByteKind::CODE;
+    }
+    analysis.self_modifying = toRanges(modified);
+
+    // Every backward jump closes a loop over the instructions between target and jump.
+    for( const CfgBlock& block : analysis.blocks )
+    {
+        const uint16_t tail{ static_cast<uint16_t>(block.end - 2) };
+        for( const CfgEdge& edge : block.successors )
+        {
+            if( (edge.kind != EdgeKind::JUMP && edge.kind != EdgeKind::INDIRECT) || edge.target > tail
+                || edge.target < MEM_ADDR_START ) continue;
+
+            ProgramLoop loop{ .head = edge.target, .tail = tail };
+            for( std::size_t addr{edge.target}; addr <= tail; ++addr )
+            {
+                if( !(marks[addr] & MARK_INSTR) ) continue;
+
+                ++loop.instructions;
+                loop.flags |= loopFlag(opcodeAt(addr));
+                if( modified[addr] || modified[addr + 1] ) loop.flags |= LOOP_SELF_MODIFYING;
+            }
+
+            if( loop.head == loop.tail && edge.kind == EdgeKind::JUMP ) loop.flags |= LOOP_HALTS;
+            if( !(loop.flags & (LOOP_WAITS_KEY | LOOP_HALTS | LOOP_SELF_MODIFYING)) ) loop.flags |= LOOP_HOT;
+            analysis.loops.push_back(loop);
+        }
+    }
+
+    std::sort(analysis.loops.begin(), analysis.loops.end(), [](const ProgramLoop& a, const ProgramLoop& b)
+    {
+        return (a.head != b.head) ? a.head < b.head : a.tail < b.tail;
+    });
+    analysis.loops.erase(std::unique(analysis.loops.begin(), analysis.loops.end(), [](const ProgramLoop& a, const ProgramLoop& b)
+    {
+        return a.head == b.head && a.tail == b.tail;
+    }), analysis.loops.end());
+
+    return analysis;
+}
+
+Profile detectProfile(const uint8_t rom[], std::size_t size)
+{
+    const ProgramAnalysis analysis{ analyzeProgram(rom, size, Profile::DEFAULT) };
+    if( analysis.uses_xochip ) return Profile::XO_CHIP;
+    if( analysis.uses_schip ) return Profile::SUPER_CHIP;
+    return Profile::DEFAULT;
+}
+
+std::string disassemble(uint16_t opcode, Profile profile)
+{
+    const unsigned x{ static_cast<unsigned>((opcode >> 8) & 0xF) };
+    const unsigned y{ static_cast<unsigned>((opcode >> 4) & 0xF) };
+    const unsigned n{ static_cast<unsigned>(opcode & 0xF) };
+    const unsigned nn{ static_cast<unsigned>(opcode & 0xFF) };
+    const unsigned nnn{ static_cast<unsigned>(opcode & 0xFFF) };
+
+    char text[32]{};
+    auto format = [&](const char* pattern, auto... values)
+    {
+        std::snprintf(text, sizeof(text), pattern, values...);
+    };
+
+    switch( opcode >> 12 )
+    {
+        case 0x0:
+            if( opcode == 0x00E0 ) format("CLS");
+            else if( opcode == 0x00EE ) format("RET");
+            else if( (opcode & 0xFFF0) == 0x00C0 ) format("SCD %u", n);
+            else if( (opcode & 0xFFF0) == 0x00D0 ) format("SCU %u", n);
+            else if( opcode == 0x00FB ) format("SCR");
+            else if( opcode == 0x00FC ) format("SCL");
+            else if( opcode == 0x00FD ) format("EXIT");
+            else if( opcode == 0x00FE ) format("LOW");
+            else if( opcode == 0x00FF ) format("HIGH");
+            else format("SYS 0x%03X", nnn);
+            break;
+        case 0x1: format("JP 0x%03X", nnn); break;
+        case 0x2: format("CALL 0x%03X", nnn); break;
+        case 0x3: format("SE V%X, 0x%02X", x, nn); break;
+        case 0x4: format("SNE V%X, 0x%02X", x, nn); break;
+        case 0x5: format("SE V%X, V%X", x, y); break;
+        case 0x6: format("LD V%X, 0x%02X", x, nn); break;
+        case 0x7: format("ADD V%X, 0x%02X", x, nn); break;
+        case 0x8:
+        {
+            static const char* const names[16]{ "LD", "OR", "AND", "XOR", "ADD", "SUB", "SHR", "SUBN",
+                nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, "SHL", nullptr };
+            if( names[n] ) format("%s V%X, V%X", names[n], x, y);
+            else format("DW 0x%04X", static_cast<unsigned>(opcode));
+            break;
+        }
+        case 0x9: format("SNE V%X, V%X", x, y); break;
+        case 0xA: format("LD I, 0x%03X", nnn); break;
+        case 0xB:
+            if( quirkFlags(profile).jump_uses_vx ) format("JP V%X, 0x%03X", x, nnn);
+            else format("JP V0, 0x%03X", nnn);
+            break;
+        case 0xC: format("RND V%X, 0x%02X", x, nn); break;
+        case 0xD: format("DRW V%X, V%X, %u", x, y, n); break;
+        case 0xE:
+            if( nn == 0x9E ) format("SKP V%X", x);
+            else if( nn == 0xA1 ) format("SKNP V%X", x);
+            else format("DW 0x%04X", static_cast<unsigned>(opcode));
+            break;
+        case 0xF:
+            switch( nn )
+            {
+                case 0x01: format("PLANE %u", x); break;
+                case 0x07: format("LD V%X, DT", x); break;
+                case 0x0A: format("LD V%X, K", x); break;
+                case 0x15: format("LD DT, V%X", x); break;
+                case 0x18: format("LD ST, V%X", x); break;
+                case 0x1E: format("ADD I, V%X", x); break;
+                case 0x29: format("LD F, V%X", x); break;
+                case 0x30: format("LD HF, V%X", x); break;
+                case 0x33: format("LD B, V%X", x); break;
+                case 0x55: format("LD [I], V%X", x); break;
+                case 0x65: format("LD V%X, [I]", x); break;
+                case 0x75: format("LD R, V%X", x); break;
+                case 0x85: format("LD V%X, R", x); break;
+                default: format("DW 0x%04X", static_cast<unsigned>(opcode)); break;
+            }
+            break;
+    }
+    return text;
+}
+
+std::vector<AddressRange> toRanges(const std::bitset<MEM_SIZE>& bits)
+{
+    std::vector<AddressRange> ranges{};
+    for( std::size_t addr{0}; addr < MEM_SIZE; ++addr )
+    {
+        if( !bits[addr] ) continue;
+
+        const std::size_t start{addr};
+        while( addr < MEM_SIZE && bits[addr] ) ++addr;
+        ranges.push_back({ static_cast<uint16_t>(start), static_cast<uint16_t>(addr) });
+    }
+    return ranges;
+}
+
+std::vector<AddressRange> toRanges(const std::array<ByteKind, MEM_SIZE>& kinds, ByteKind kind)
+{
+    std::bitset<MEM_SIZE> bits{};
+    for( std::size_t addr{0}; addr < MEM_SIZE; ++addr ) bits[addr] = kinds[addr] == kind;
+    return toRanges(bits);
+}
+
+const char* edgeKindName(EdgeKind kind)
+{
+    switch(kind)
+    {
+        case EdgeKind::JUMP:        return "jump";
+        case EdgeKind::CALL:        return "call";
+        case EdgeKind::RETURN_SITE: return "return";
+        case EdgeKind::SKIP:        return "skip";
+        case EdgeKind::INDIRECT:    return "indirect";
+        default:                    return "fallthrough";
+    }
+}
+
+static std::string hexAddress(uint16_t addr)
+{
+    char text[8]{};
+    std::snprintf(text, sizeof(text), "0x%03X", static_cast<unsigned>(addr));
+    return text;
+}
+
+// The instructions of a block, found in the sorted instruction list.
+static std::pair<std::size_t, std::size_t> instructionsOf(const ProgramAnalysis& analysis, const CfgBlock& block)
+{
+    auto first{ std::lower_bound(analysis.instructions.begin(), analysis.instructions.end(), block.start,
+        [](const DecodedInstruction& instruction, uint16_t addr) { return instruction.addr < addr; }) };
+    auto last{ std::lower_bound(first, analysis.instructions.end(), block.end,
+        [](const DecodedInstruction& instruction, uint16_t addr) { return instruction.addr < addr; }) };
+    return { static_cast<std::size_t>(first - analysis.instructions.begin()),
+        static_cast<std::size_t>(last - analysis.instructions.begin()) };
+}
+
+void writeDot(const ProgramAnalysis& analysis, std::ostream& os)
+{
+    std::vector<uint16_t> hot_heads{};
+    for( const ProgramLoop& loop : analysis.loops )
+    {
+        if( loop.flags & LOOP_HOT ) hot_heads.push_back(loop.head);
+    }
+
+    os << "digraph chip8 {\n";
+    os << "    node [shape=box, fontname=\"monospace\"];\n";
+
+    // Blocks that may be overwritten are red, heads of hot loops bold.
+    for( const CfgBlock& block : analysis.blocks )
+    {
+        os << "    b" << std::hex << block.start << std::dec << " [label=\"";
+        const auto [first, last] = instructionsOf(analysis, block);
+        for( std::size_t i{first}; i < last; ++i )
+        {
+            const DecodedInstruction& instruction{ analysis.instructions[i] };
+            os << hexAddress(instruction.addr) << "  " << disassemble(instruction.opcode, analysis.profile) << "\\l";
+        }
+        os << "\"";
+
+        bool modified{false};
+        for( std::size_t addr{block.start}; addr < block.end; ++addr ) modified |= analysis.write_targets[addr];
+        if( modified ) os << ", color=red";
+        if( std::find(hot_heads.begin(), hot_heads.end(), block.start) != hot_heads.end() ) os << ", style=bold";
+        os << "];\n";
+    }
+
+    for( const CfgBlock& block : analysis.blocks )
+    {
+        for( const CfgEdge& edge : block.successors )
+        {
+            if( analysis.blockAt(edge.target) == nullptr ) continue;
+
+            os << "    b" << std::hex << block.start << " -> b" << edge.target << std::dec << " [label=\""
+               << edgeKindName(edge.kind) << "\"" << ((edge.kind == EdgeKind::RETURN_SITE) ? ", style=dashed" : "") << "];\n";
+        }
+    }
+    os << "}\n";
+}
+
+static void writeRanges(std::ostream& os, const std::vector<AddressRange>& ranges)
+{
+    os << "[";
+    for( std::size_t i{0}; i < ranges.size(); ++i )
+    {
+        os << (i ? ", " : "") << "[" << ranges[i].start << ", " << ranges[i].end << "]";
+    }
+    os << "]";
+}
+
+void writeJson(const ProgramAnalysis& analysis, std::ostream& os)
+{
+    static const std::pair<uint8_t, const char*> flag_names[]{ { LOOP_DRAWS, "draws" }, { LOOP_READS_KEYS, "reads_keys" },
+        { LOOP_POLLS_TIMER, "polls_timer" }, { LOOP_WAITS_KEY, "waits_key" }, { LOOP_CALLS, "calls" },
+        { LOOP_HALTS, "halts" }, { LOOP_SELF_MODIFYING, "self_modifying" }, { LOOP_HOT, "hot" } };
+
+    os << "{\n  \"profile\": \"" << profileName(analysis.profile) << "\",\n";
+    os << "  \"rom_size\": " << analysis.rom_size << ",\n";
+    os << "  \"uses_schip\": " << (analysis.uses_schip ? "true" : "false") << ",\n";
+    os << "  \"uses_xochip\": " << (analysis.uses_xochip ? "true" : "false") << ",\n";
+
+    os << "  \"blocks\": [";
+    for( std::size_t b{0}; b < analysis.blocks.size(); ++b )
+    {
+        const CfgBlock& block{ analysis.blocks[b] };
+        os << (b ? "," : "") << "\n    {\"start\": " << block.start << ", \"end\": " << block.end << ", \"instructions\": [";
+
+        const auto [first, last] = instructionsOf(analysis, block);
+        for( std::size_t i{first}; i < last; ++i )
+        {
+            const DecodedInstruction& instruction{ analysis.instructions[i] };
+            char opcode[8]{};
+            std::snprintf(opcode, sizeof(opcode), "%04X", static_cast<unsigned>(instruction.opcode));
+
+            os << (i > first ? ", " : "") << "{\"addr\": " << instruction.addr << ", \"opcode\": \"" << opcode
+               << "\", \"text\": \"" << disassemble(instruction.opcode, analysis.profile) << "\", \"index\": ";
+            if( instruction.index == UNKNOWN_VALUE ) os << "null}";
+            else os << instruction.index << "}";
+        }
+
+        os << "], \"successors\": [";
+        for( std::size_t e{0}; e < block.successors.size(); ++e )
+        {
+            os << (e ? ", " : "") << "{\"target\": " << block.successors[e].target << ", \"kind\": \""
+               << edgeKindName(block.successors[e].kind) << "\"}";
+        }
+        os << "]}";
+    }
+    os << "\n  ],\n";
+
+    os << "  \"loops\": [";
+    for( std::size_t l{0}; l < analysis.loops.size(); ++l )
+    {
+        const ProgramLoop& loop{ analysis.loops[l] };
+        os << (l ? "," : "") << "\n    {\"head\": " << loop.head << ", \"tail\": " << loop.tail
+           << ", \"instructions\": " << loop.instructions << ", \"flags\": [";
+
+        bool first{true};
+        for( const auto& [flag, name] : flag_names )
+        {
+            if( !(loop.flags & flag) ) continue;
+            os << (first ? "" : ", ") << "\"" << name << "\"";
+            first = false;
+        }
+        os << "]}";
+    }
+    os << "\n  ],\n";
+
+    os << "  \"indirect_jumps\": [";
+    for( std::size_t j{0}; j < analysis.indirect_jumps.size(); ++j )
+    {
+        const IndirectJump& jump{ analysis.indirect_jumps[j] };
+        os << (j ? ", " : "") << "{\"addr\": " << jump.addr << ", \"targets\": [";
+        for( std::size_t t{0}; t < jump.targets.size(); ++t ) os << (t ? ", " : "") << jump.targets[t];
+        os << "]}";
+    }
+    os << "],\n";
+
+    os << "  \"code\": ";
+    writeRanges(os, toRanges(analysis.kinds, ByteKind::CODE));
+    os << ",\n  \"sprites\": ";
+    writeRanges(os, toRanges(analysis.kinds, ByteKind::SPRITE));
+    os << ",\n  \"write_targets\": ";
+    writeRanges(os, toRanges(analysis.write_targets));
+    os << ",\n  \"self_modifying\": ";
+    writeRanges(os, analysis.self_modifying);
+    os << ",\n  \"unresolved_writes\": " << analysis.unresolved_writes << "\n}\n";
+}
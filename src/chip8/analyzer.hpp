@@ -0,0 +1,160 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Declares the static ROM analyzer. It disassembles recursively from
+    MEM_ADDR_START, following jumps, calls, both sides of skips and the
+    targets of BNNN it can resolve, and builds the control-flow graph of the
+    reachable code. A constant propagation pass over the graph tracks I and
+    the registers where they are known, which places the bytes DXYN reads
+    (sprite data) and FX55/FX33 write. The results are meant to be used
+    before a ROM runs: the decoded instructions for pre-decoding, the code
+    bytes that may be overwritten, and the loops worth optimizing.
+
+    The analysis models this interpreter, so an opcode it ignores, such as
+    an XO-CHIP F000 NNNN, is a two byte no-op here as well.
+*/
+
+#ifndef ANALYZER_H
+#define ANALYZER_H
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "quirks.hpp"
+#include "state.hpp"
+
+#define ROM_MAX_SIZE (MEM_ADDR_END - MEM_ADDR_START)
+
+// Loop flags. The first four are set when the body contains the instruction.
+#define LOOP_DRAWS 0x01
+#define LOOP_READS_KEYS 0x02
+#define LOOP_POLLS_TIMER 0x04
+#define LOOP_WAITS_KEY 0x08
+#define LOOP_CALLS 0x10
+// A jump to itself, how most ROMs stop.
+#define LOOP_HALTS 0x20
+// Part of the body may be overwritten by FX55/FX33, which is all of it when
+// any of them writes through an unknown I.
+#define LOOP_SELF_MODIFYING 0x40
+// Runs without waiting on a key, halting or rewriting itself.
+#define LOOP_HOT 0x80
+
+// A value the constant propagation could not work out.
+#define UNKNOWN_VALUE -1
+
+enum class ByteKind : uint8_t
+{
+    UNKNOWN,
+    CODE,
+    SPRITE
+};
+
+enum class EdgeKind : uint8_t
+{
+    FALLTHROUGH,
+    JUMP,
+    CALL,
+    // From a call to the instruction after it, taken when the subroutine returns.
+    RETURN_SITE,
+    SKIP,
+    INDIRECT
+};
+
+struct DecodedInstruction
+{
+    uint16_t addr{};
+    uint16_t opcode{};
+
+    // I before the instruction runs, or UNKNOWN_VALUE.
+    int32_t index{UNKNOWN_VALUE};
+};
+
+struct CfgEdge
+{
+    uint16_t target{};
+    EdgeKind kind{};
+};
+
+// Instructions from start up to, not including, end.
+struct CfgBlock
+{
+    uint16_t start{};
+    uint16_t end{};
+    std::vector<CfgEdge> successors{};
+};
+
+// A backward jump from tail to head; the body is every instruction between them.
+struct ProgramLoop
+{
+    uint16_t head{};
+    uint16_t tail{};
+    uint16_t instructions{};
+    uint8_t flags{};
+};
+
+// No targets if neither the register nor a jump table at NNN gave any.
+struct IndirectJump
+{
+    uint16_t addr{};
+    std::vector<uint16_t> targets{};
+};
+
+struct AddressRange
+{
+    uint16_t start{};
+    uint16_t end{};
+};
+
+struct ProgramAnalysis
+{
+    Profile profile{};
+    std::size_t rom_size{};
+
+    // Sorted by address.
+    std::vector<DecodedInstruction> instructions{};
+    std::vector<CfgBlock> blocks{};
+    std::vector<ProgramLoop> loops{};
+    std::vector<IndirectJump> indirect_jumps{};
+
+    std::array<ByteKind, MEM_SIZE> kinds{};
+    std::bitset<MEM_SIZE> write_targets{};
+
+    // FX55/FX33 whose I is unknown; each may write anywhere.
+    std::size_t unresolved_writes{};
+
+    // Code bytes that are also write targets, or all code bytes when
+    // unresolved_writes is not 0.
+    std::vector<AddressRange> self_modifying{};
+
+    // Whether a reachable opcode only exists on SUPER-CHIP or XO-CHIP.
+    bool uses_schip{};
+    bool uses_xochip{};
+
+    // The block starting at addr, nullptr if none does.
+    const CfgBlock* blockAt(uint16_t addr) const;
+};
+
+ProgramAnalysis analyzeProgram(const uint8_t rom[], std::size_t size, Profile profile);
+
+// XO_CHIP or SUPER_CHIP if the reachable opcodes call for them, else DEFAULT.
+Profile detectProfile(const uint8_t rom[], std::size_t size);
+
+std::string disassemble(uint16_t opcode, Profile profile = Profile::DEFAULT);
+
+// Consecutive set bits, or bytes of one kind, as ranges.
+std::vector<AddressRange> toRanges(const std::bitset<MEM_SIZE>& bits);
+std::vector<AddressRange> toRanges(const std::array<ByteKind, MEM_SIZE>& kinds, ByteKind kind);
+
+const char* edgeKindName(EdgeKind kind);
+
+// Graphviz digraph of the blocks, each labelled with its disassembly.
+void writeDot(const ProgramAnalysis& analysis, std::ostream& os);
+void writeJson(const ProgramAnalysis& analysis, std::ostream& os);
+
+#endif
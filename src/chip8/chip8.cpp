@@ -14,27 +14,34 @@
 #include "header.hpp"
 #include "logger.hpp"
 #include "chip8.hpp"
+#include "debugger.hpp"
 
-Chip8::Chip8(Bus& bus) : Component("chip8_log.txt", bus)
+template<typename Quirks>
+inline void advanceIndex(uint16_t& index_reg, uint16_t reg_X)
 {
-    this->reset();
-};
+    if constexpr (Quirks::load_store == IndexIncrement::X_PLUS_ONE) index_reg += reg_X + 1;
+    if constexpr (Quirks::load_store == IndexIncrement::X) index_reg += reg_X;
+}
 
-Chip8::~Chip8() 
+Chip8::Chip8(Bus& bus) : Component("chip8_log.txt", bus)
 {
-    delete[] memory;
+    this->reset();
+    this->setProfile(Profile::DEFAULT);
 };
 
 void Chip8::setStatusReg(bool status)
 {
-    reg[0xF] = status ? 0x01 : 0x00;
+    state.reg[0xF] = status ? 0x01 : 0x00;
 }
 
-bool Chip8::loadData(uint16_t addr, uint8_t data[], int size) 
+bool Chip8::loadData(uint16_t addr, const uint8_t data[], int size) 
 {
     if(addr > MEM_ADDR_END - size) return false;
 
-    std::copy(data, data+size, memory+addr);
+    for(int i{0}; i < size; ++i)
+    {
+        state.write(addr + i, data[i]);
+    }
     return true;
 };
 
@@ -59,9 +66,10 @@ bool Chip8::loadProgram(std::string file)
         return false;
     }
 
-    is.read(reinterpret_cast<char *>(memory+MEM_ADDR_START), size);
+    is.read(reinterpret_cast<char *>(state.memory.data()+MEM_ADDR_START), size);
+    state.rehashMemory();
 
-    pc = MEM_ADDR_START;
+    state.pc = MEM_ADDR_START;
 
     is.close();
     return true;
@@ -69,40 +77,158 @@ bool Chip8::loadProgram(std::string file)
 
 void Chip8::tickTimer()
 {
-    delay -= (delay > 0);
-    sound -= (sound > 0);
+    state.delay -= (state.delay > 0);
+    state.sound -= (state.sound > 0);
 };
 
 void Chip8::reset()
 {
-    index_reg = 0;
-    pc = MEM_ADDR_START;
-    sp = 0;
-    delay = 0;
-    sound = 0;
+    state.reset();
+    state.setBigFont(hasSchipOpcodes(profile));
+};
 
-    delete[] memory;
+uint64_t Chip8::hash() const
+{
+    return state.hash();
+};
 
-    std::fill(std::begin( reg ), std::end( reg ), 0);
-    std::fill(std::begin( stack ), std::end( stack ), 0);
-    
-    memory = new uint8_t[4096]{};
+const Chip8State& Chip8::getState() const
+{
+    return state;
+};
 
-    uint8_t sprite_data[HEX_SPRITE_LENGTH]{HEX_SPRITE_DATA};
-    this->loadData(ADDR_SPRITE, &(sprite_data[0]), 16*5);
+void Chip8::setState(const Chip8State& state)
+{
+    this->state = state;
 };
 
 uint16_t Chip8::fetch()
 {
-    if(pc >= MEM_ADDR_END)
+    // Running off the program area restarts it; a select, not a branch.
+    state.pc = (state.pc >= MEM_ADDR_END) ? MEM_ADDR_START : state.pc;
+
+    const uint8_t* bytes{ state.span(state.pc) };
+    return static_cast<uint16_t>((bytes[0] << 8) | bytes[1]);
+};
+
+void Chip8::setProfile(Profile profile)
+{
+    // Only profiles with the SUPER-CHIP opcodes can point I at the big font.
+    // Memory a ROM may use below 0x200 is only touched when the font changes.
+    if( hasSchipOpcodes(profile) != hasSchipOpcodes(this->profile) ) state.setBigFont(hasSchipOpcodes(profile));
+    this->profile = profile;
+
+    switch(profile)
+    {
+        case Profile::DEFAULT:
+            runner = &Chip8::run<quirks::Default>;
+            debug_runner = &Chip8::runDebug<quirks::Default>;
+            break;
+        case Profile::COSMAC_VIP:
+            runner = &Chip8::run<quirks::CosmacVip>;
+            debug_runner = &Chip8::runDebug<quirks::CosmacVip>;
+            break;
+        case Profile::CHIP_48:
+            runner = &Chip8::run<quirks::Chip48>;
+            debug_runner = &Chip8::runDebug<quirks::Chip48>;
+            break;
+        case Profile::SUPER_CHIP:
+            runner = &Chip8::run<quirks::SuperChip>;
+            debug_runner = &Chip8::runDebug<quirks::SuperChip>;
+            break;
+        case Profile::XO_CHIP:
+            runner = &Chip8::run<quirks::XoChip>;
+            debug_runner = &Chip8::runDebug<quirks::XoChip>;
+            break;
+    }
+};
+
+Profile Chip8::getProfile() const
+{
+    return profile;
+};
+
+std::size_t Chip8::cycle(std::size_t count)
+{
+    return (this->*runner)(count);
+};
+
+std::size_t Chip8::cycle(Debugger& debugger, std::size_t count)
+{
+    return (this->*debug_runner)(debugger, count);
+};
+
+template<typename Quirks>
+std::size_t Chip8::run(std::size_t count)
+{
+    NoHooks hooks{};
+    for(std::size_t i{0}; i < count; ++i)
     {
-        pc = MEM_ADDR_START;
+        const uint16_t opcode{ fetch() };
+        executeAs<Quirks>(opcode, hooks);
+
+        if constexpr (Quirks::display_wait)
+        {
+            if((opcode & 0xF000) == 0xD000) return i + 1;
+        }
     }
+    return count;
+};
+
+// run() with the debugger's checks around each instruction. The display wait
+// is the same, so switching between the two loops keeps the machine in step.
+template<typename Quirks>
+std::size_t Chip8::runDebug(Debugger& debugger, std::size_t count)
+{
+    for(std::size_t i{0}; i < count; ++i)
+    {
+        const uint16_t opcode{ fetch() };
+        if( !debugger.enter(state) ) return i;
+
+        executeAs<Quirks>(opcode, debugger);
+        if( !debugger.leave(state) ) return i + 1;
 
-    return static_cast<uint16_t>((memory[pc] << 8) + memory[pc+1]);
+        if constexpr (Quirks::display_wait)
+        {
+            if((opcode & 0xF000) == 0xD000) return i + 1;
+        }
+    }
+    return count;
 };
 
 void Chip8::execute(uint16_t opcode)
+{
+    NoHooks hooks{};
+    execute(opcode, hooks);
+};
+
+// Single instructions pick the profile at runtime; bursts go through run()
+// or runDebug().
+template<typename Hooks>
+void Chip8::execute(uint16_t opcode, Hooks& hooks)
+{
+    switch(profile)
+    {
+        case Profile::DEFAULT:
+            executeAs<quirks::Default>(opcode, hooks);
+            break;
+        case Profile::COSMAC_VIP:
+            executeAs<quirks::CosmacVip>(opcode, hooks);
+            break;
+        case Profile::CHIP_48:
+            executeAs<quirks::Chip48>(opcode, hooks);
+            break;
+        case Profile::SUPER_CHIP:
+            executeAs<quirks::SuperChip>(opcode, hooks);
+            break;
+        case Profile::XO_CHIP:
+            executeAs<quirks::XoChip>(opcode, hooks);
+            break;
+    }
+};
+
+template<typename Quirks, typename Hooks>
+void Chip8::executeAs(uint16_t opcode, Hooks& hooks)
 {   
     uint16_t address_3B{ static_cast<uint16_t>(opcode & 0x0FFF) };
     uint16_t address_2B{ static_cast<uint16_t>(opcode & 0x00FF) };
@@ -111,116 +237,160 @@ void Chip8::execute(uint16_t opcode)
     uint16_t reg_X{ static_cast<uint16_t>((opcode & 0x0F00) >> 8) };
     uint16_t reg_Y{ static_cast<uint16_t>((opcode & 0x00F0) >> 4) };
 
-    logger << std::hex << +pc << ":" << +opcode << "\t[";
+    logger << std::hex << +state.pc << ":" << +opcode << "\t[";
     for(int i{0}; i <= 15; ++i)
     {
-        logger << std::hex << +reg[i] << " ";
+        logger << std::hex << +state.reg[i] << " ";
     }
     logger << "]" << std::endl; 
 
-    pc += 2;
+    state.pc += 2;
     switch( (opcode & 0xF000) >> 12 )
     {
         case 0x0:
             if( opcode == 0x00E0 )
             {
-                bus.notify({ .type = EventType::DISPLAY_CLEAR });
+                bus.notify({ .type = EventType::DISPLAY_CLEAR, .planes = state.planes });
             }
             else if( opcode == 0x00EE )
             {
-                sp -= (sp > 0);
-                pc = stack[sp];
+                state.sp -= (state.sp > 0);
+                state.pc = state.stack[state.sp];
+            }
+            else if( Quirks::schip_opcodes && (opcode & 0xFFF0) == 0x00C0 )
+            {
+                scrollScreen(0, address_1B);
+            }
+            else if( Quirks::xochip_opcodes && (opcode & 0xFFF0) == 0x00D0 )
+            {
+                scrollScreen(0, -address_1B);
+            }
+            else if( Quirks::schip_opcodes && opcode == 0x00FB )
+            {
+                scrollScreen(4, 0);
+            }
+            else if( Quirks::schip_opcodes && opcode == 0x00FC )
+            {
+                scrollScreen(-4, 0);
+            }
+            else if( Quirks::schip_opcodes && opcode == 0x00FD )
+            {
+                // Exiting parks the interpreter on this instruction.
+                state.pc -= 2;
+            }
+            else if( Quirks::schip_opcodes && (opcode == 0x00FE || opcode == 0x00FF) )
+            {
+                bus.notify({ .type = EventType::DISPLAY_MODE, .hires = opcode == 0x00FF });
             }
             break;
         case 0x1:
-            pc = address_3B;
+            state.pc = address_3B;
             break;
         case 0x2:
-            stack[sp] = pc;
-            sp += (sp < 15);
-            pc = address_3B;
+            state.stack[state.sp] = state.pc;
+            state.sp += (state.sp < 15);
+            state.pc = address_3B;
             break;
         case 0x3:
-            pc += (reg[reg_X] == address_2B) ? 2 : 0;
+            state.pc += (state.reg[reg_X] == address_2B) ? 2 : 0;
             break;
         case 0x4:
-            pc += (reg[reg_X] != address_2B) ? 2 : 0;
+            state.pc += (state.reg[reg_X] != address_2B) ? 2 : 0;
             break;
         case 0x5:
-            pc += (reg[reg_X] == reg[reg_Y]) ? 2 : 0;
+            state.pc += (state.reg[reg_X] == state.reg[reg_Y]) ? 2 : 0;
             break;
         case 0x6:
-            reg[reg_X] = address_2B;
+            state.reg[reg_X] = address_2B;
             break;
         case 0x7:
-            reg[reg_X] += address_2B;
+            state.reg[reg_X] += address_2B;
             break;
         case 0x8:
             switch(address_1B)
             {
                 case 0x0:
-                    reg[reg_X] = reg[reg_Y];
+                    state.reg[reg_X] = state.reg[reg_Y];
                     break;
                 case 0x1:
-                    reg[reg_X] |= reg[reg_Y];
+                    state.reg[reg_X] |= state.reg[reg_Y];
+                    if constexpr (Quirks::logic_resets_vf) setStatusReg(false);
                     break;
                 case 0x2:
-                    reg[reg_X] &= reg[reg_Y];
+                    state.reg[reg_X] &= state.reg[reg_Y];
+                    if constexpr (Quirks::logic_resets_vf) setStatusReg(false);
                     break;
                 case 0x3:
-                    reg[reg_X] ^= reg[reg_Y];
+                    state.reg[reg_X] ^= state.reg[reg_Y];
+                    if constexpr (Quirks::logic_resets_vf) setStatusReg(false);
                     break;
                 case 0x4:
-                    setStatusReg(0xFF - reg[reg_X] < reg[reg_Y]);
-                    reg[reg_X] += reg[reg_Y];
+                    setStatusReg(0xFF - state.reg[reg_X] < state.reg[reg_Y]);
+                    state.reg[reg_X] += state.reg[reg_Y];
                     break;
                 case 0x5:
-                    setStatusReg(reg[reg_X] > reg[reg_Y]);
-                    reg[reg_X] -= reg[reg_Y];
+                    setStatusReg(state.reg[reg_X] > state.reg[reg_Y]);
+                    state.reg[reg_X] -= state.reg[reg_Y];
                     break;
                 case 0x6:
-                    setStatusReg((reg[reg_Y] & 0x01) != 0);
-                    reg[reg_X] = reg[reg_Y] >> 1;
+                {
+                    const uint8_t source{ state.reg[Quirks::shift_uses_vy ? reg_Y : reg_X] };
+                    setStatusReg((source & 0x01) != 0);
+                    state.reg[reg_X] = source >> 1;
                     break;
+                }
                 case 0x7:
-                    setStatusReg(reg[reg_X] < reg[reg_Y]);
-                    reg[reg_X] = reg[reg_Y] - reg[reg_X];
+                    setStatusReg(state.reg[reg_X] < state.reg[reg_Y]);
+                    state.reg[reg_X] = state.reg[reg_Y] - state.reg[reg_X];
                     break;
                 case 0xE:
-                    setStatusReg((reg[reg_Y] & 0x80) != 0);
-                    reg[reg_X] = reg[reg_Y] << 1;
+                {
+                    const uint8_t source{ state.reg[Quirks::shift_uses_vy ? reg_Y : reg_X] };
+                    setStatusReg((source & 0x80) != 0);
+                    state.reg[reg_X] = source << 1;
                     break;
+                }
             }
             break;
         case 0x9:
-            pc += (reg[reg_X] != reg[reg_Y]) ? 2 : 0;
+            state.pc += (state.reg[reg_X] != state.reg[reg_Y]) ? 2 : 0;
             break;
         case 0xA:
-            index_reg = address_3B;
+            state.index_reg = address_3B;
             break;
         case 0xB:
-            pc = address_3B + reg[0];
+            state.pc = address_3B + state.reg[Quirks::jump_uses_vx ? reg_X : 0];
             break;
         case 0xC:
             bus.notify({
                 .type = EventType::RANDOM,
                 .random = {
                     .mask = static_cast<uint8_t>(address_2B),
-                    .dest = &reg[reg_X]
+                    .dest = &state.reg[reg_X]
                 }
             });
             break;
         case 0xD:
+        {
+            // DXY0 draws a 16x16 sprite, two bytes per row.
+            const bool wide{ Quirks::schip_opcodes && address_1B == 0 };
+            const std::size_t rows{ wide ? 16u : address_1B };
+
+            hooks.read(state.index_reg, rows * (wide ? 2 : 1) * __builtin_popcount(state.planes));
             bus.notify({ 
                 .type = EventType::DISPLAY_DRAW,
                 .draw = {
-                    .xpos = reg[reg_X],
-                    .ypos = reg[reg_Y],
-                    .data = memory + index_reg,
-                    .size = address_1B
+                    .xpos = state.reg[reg_X],
+                    .ypos = state.reg[reg_Y],
+                    .data = state.span(state.index_reg),
+                    .size = rows,
+                    .wrap = Quirks::draw_wraps,
+                    .wide = wide,
+                    .planes = state.planes
                 }
             });
             break;
+        }
         case 0xE:
         {
             uint8_t key{0x10};
@@ -229,60 +399,107 @@ void Chip8::execute(uint16_t opcode)
                 .key = &key,
             });
 
-            if(reg[reg_X] > 0xF) break;
+            if(state.reg[reg_X] > 0xF) break;
 
-            pc += ((address_2B == 0x9E && reg[reg_X] == key) 
-                || (address_2B == 0xA1 && reg[reg_X] != key)) ? 2 : 0;
+            state.pc += ((address_2B == 0x9E && state.reg[reg_X] == key) 
+                || (address_2B == 0xA1 && state.reg[reg_X] != key)) ? 2 : 0;
             break;
         }
         case 0xF:
             switch(address_2B)
             {
+                case 0x01:
+                    // FN01 selects the planes later draws, clears and scrolls use.
+                    if constexpr (Quirks::xochip_opcodes) state.planes = reg_X & ((1 << PLANES) - 1);
+                    break;
                 case 0x07:
-                    reg[reg_X] = delay;
+                    state.reg[reg_X] = state.delay;
                     break;
                 case 0x0A:
                     bus.notify({ 
                         .type = EventType::KEYBOARD_GET,
-                        .key = &reg[reg_X]
+                        .key = &state.reg[reg_X]
                     });
-                    pc -= (reg[reg_X] == KEY_NOTPRESSED) ? 2 : 0;
+                    state.pc -= (state.reg[reg_X] == KEY_NOTPRESSED) ? 2 : 0;
                     break;
                 case 0x15:
-                    delay = reg[reg_X];
+                    state.delay = state.reg[reg_X];
                     break;
                 case 0x18:
-                    sound = reg[reg_X];
+                    state.sound = state.reg[reg_X];
                     break;
                 case 0x1E:
-                    index_reg += reg[reg_X]; 
+                    state.index_reg += state.reg[reg_X]; 
                     break;
                 case 0x29:
-                    index_reg = ADDR_SPRITE + reg[reg_X]*5;
+                    state.index_reg = ADDR_SPRITE + state.reg[reg_X]*5;
+                    break;
+                case 0x30:
+                    if constexpr (Quirks::schip_opcodes) state.index_reg = ADDR_BIG_SPRITE + (state.reg[reg_X] & 0xF)*10;
                     break;
                 case 0x33:
                 {   
-                    uint16_t bcd{reg[reg_X]};
+                    hooks.write(state.index_reg, 3);
+                    uint16_t bcd{state.reg[reg_X]};
                     for(std::size_t i{0}; i <= 2; ++i) 
                     {
-                        memory[index_reg + (2 - i)] = bcd % 10;
+                        state.write(state.index_reg + (2 - i), bcd % 10);
                         bcd /= 10;
                     }
                     break;
                 }
                 case 0x55:
+                    hooks.write(state.index_reg, reg_X + 1);
                     for(std::size_t i{0}; i <= reg_X; ++i)
                     {
-                        memory[index_reg + i] = reg[i];
+                        state.write(state.index_reg + i, state.reg[i]);
                     }
+                    advanceIndex<Quirks>(state.index_reg, reg_X);
                     break;
                 case 0x65:
+                {
+                    hooks.read(state.index_reg, reg_X + 1);
+                    const uint8_t* bytes{ state.span(state.index_reg) };
                     for(std::size_t i{0}; i <= reg_X; ++i)
                     {
-                        reg[i] = memory[index_reg + i];
+                        state.reg[i] = bytes[i];
                     }
+                    advanceIndex<Quirks>(state.index_reg, reg_X);
+                    break;
+                }
+                case 0x75:
+                    if constexpr (Quirks::schip_opcodes) std::copy_n(state.reg, reg_X + 1, state.flags);
+                    break;
+                case 0x85:
+                    if constexpr (Quirks::schip_opcodes) std::copy_n(state.flags, reg_X + 1, state.reg);
                     break;
             }
             break;
     }
-};
\ No newline at end of file
+};
+
+void Chip8::scrollScreen(int dx, int dy)
+{
+    bus.notify({
+        .type = EventType::DISPLAY_SCROLL,
+        .scroll = {
+            .dx = static_cast<int8_t>(dx),
+            .dy = static_cast<int8_t>(dy),
+            .planes = state.planes
+        }
+    });
+};
+
+template void Chip8::execute<NoHooks>(uint16_t opcode, NoHooks& hooks);
+
+template std::size_t Chip8::run<quirks::Default>(std::size_t count);
+template std::size_t Chip8::run<quirks::CosmacVip>(std::size_t count);
+template std::size_t Chip8::run<quirks::Chip48>(std::size_t count);
+template std::size_t Chip8::run<quirks::SuperChip>(std::size_t count);
+template std::size_t Chip8::run<quirks::XoChip>(std::size_t count);
+
+template std::size_t Chip8::runDebug<quirks::Default>(Debugger& debugger, std::size_t count);
+template std::size_t Chip8::runDebug<quirks::CosmacVip>(Debugger& debugger, std::size_t count);
+template std::size_t Chip8::runDebug<quirks::Chip48>(Debugger& debugger, std::size_t count);
+template std::size_t Chip8::runDebug<quirks::SuperChip>(Debugger& debugger, std::size_t count);
+template std::size_t Chip8::runDebug<quirks::XoChip>(Debugger& debugger, std::size_t count);
@@ -9,52 +9,81 @@
 #ifndef CHIP8_H
 #define CHIP8_H
 
-#define MEM_ADDR_START 0x200
-#define MEM_ADDR_END 0xE8F
-
-#define MEM_SIZE 4096
-
-#define ADDR_SPRITE 0x000
-
 #include <cstdint>
 #include <fstream>
 #include <string>
 
 #include "header.hpp"
 #include "bus.hpp"
+#include "quirks.hpp"
+#include "state.hpp"
 
 class InstructionFailed;
+class Debugger;
+
+// Memory access hooks of the production interpreter. Every call inlines away,
+// so execute(opcode) pays nothing for the debug variant (see debugger.hpp).
+struct NoHooks
+{
+    void read(uint16_t, std::size_t) {};
+    void write(uint16_t, std::size_t) {};
+};
 
 class Chip8 : public Component
 {
     private:
-        uint8_t reg[16]{};
-        uint16_t index_reg{};
+        Chip8State state{};
+
+        Profile profile{};
+        std::size_t (Chip8::*runner)(std::size_t count){};
+        std::size_t (Chip8::*debug_runner)(Debugger& debugger, std::size_t count){};
 
-        uint8_t *memory{ new uint8_t[MEM_SIZE]{} };
-        uint16_t pc{};
+        template<typename Quirks, typename Hooks>
+        void executeAs(uint16_t opcode, Hooks& hooks);
 
-        uint16_t stack[16]{};
-        uint8_t sp{};
+        template<typename Quirks>
+        std::size_t run(std::size_t count);
 
-        uint8_t delay{};
-        uint8_t sound{};
+        template<typename Quirks>
+        std::size_t runDebug(Debugger& debugger, std::size_t count);
+
+        void scrollScreen(int dx, int dy);
 
     public:
         Chip8(Bus& bus);
-        ~Chip8();
 
         void setStatusReg(bool status);
 
-        bool loadData(uint16_t addr, uint8_t data[], int size);
+        bool loadData(uint16_t addr, const uint8_t data[], int size);
         bool loadProgram(std::string file);
 
         void tickTimer();
 
         void reset();
 
+        uint64_t hash() const;
+
+        const Chip8State& getState() const;
+        void setState(const Chip8State& state);
+
+        // Selects the quirks used by both cycle()s and execute(), see quirks.hpp.
+        void setProfile(Profile profile);
+        Profile getProfile() const;
+
         uint16_t fetch();
         void execute(uint16_t opcode);
+
+        // Hooks are told about every memory range an instruction reads or
+        // writes through index_reg. Instantiated for NoHooks.
+        template<typename Hooks>
+        void execute(uint16_t opcode, Hooks& hooks);
+
+        // Fetches and executes up to count instructions and returns how many
+        // ran; profiles that wait for the display end the burst on DXYN.
+        std::size_t cycle(std::size_t count);
+
+        // The same burst under the debugger, which also ends it when it stops.
+        std::size_t cycle(Debugger& debugger, std::size_t count);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,176 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Defines the breakpoint and watchpoint engine.
+*/
+
+#include <cstring>
+
+#include "chip8.hpp"
+#include "debugger.hpp"
+
+void Debugger::watchAccess(std::bitset<MEM_SIZE>& watch, uint16_t addr, std::size_t size, bool set)
+{
+    for( std::size_t i{0}; i < size; ++i )
+    {
+        const std::size_t index{ (addr + i) % MEM_SIZE };
+        armed_count += (set && !watch[index]);
+        armed_count -= (!set && watch[index]);
+        watch[index] = set;
+    }
+};
+
+void Debugger::setBreakpoint(uint16_t addr, bool set)
+{
+    watchAccess(breakpoints, addr, 1, set);
+};
+
+void Debugger::watchRead(uint16_t addr, std::size_t size, bool set)
+{
+    watchAccess(read_watch, addr, size, set);
+};
+
+void Debugger::watchWrite(uint16_t addr, std::size_t size, bool set)
+{
+    watchAccess(write_watch, addr, size, set);
+};
+
+void Debugger::watchRegister(uint8_t reg, bool set)
+{
+    const uint16_t bit{ static_cast<uint16_t>(1 << (reg & 0xF)) };
+    armed_count += (set && !(change_watch & bit));
+    armed_count -= (!set && (change_watch & bit));
+    change_watch = set ? (change_watch | bit) : (change_watch & ~bit);
+};
+
+void Debugger::watchRegisterEqual(uint8_t reg, uint8_t value, bool set)
+{
+    const uint16_t bit{ static_cast<uint16_t>(1 << (reg & 0xF)) };
+    armed_count += (set && !(equal_watch & bit));
+    armed_count -= (!set && (equal_watch & bit));
+    equal_watch = set ? (equal_watch | bit) : (equal_watch & ~bit);
+    reg_values[reg & 0xF] = value;
+};
+
+void Debugger::clear()
+{
+    breakpoints.reset();
+    read_watch.reset();
+    write_watch.reset();
+    change_watch = 0;
+    equal_watch = 0;
+    armed_count = 0;
+    resuming = false;
+};
+
+bool Debugger::armed() const
+{
+    return armed_count > 0;
+};
+
+StopReason Debugger::run(Chip8& cpu, std::size_t count)
+{
+    reason = StopReason::NONE;
+    cpu.cycle(*this, count);
+    return reason;
+};
+
+bool Debugger::enter(const Chip8State& state)
+{
+    pc = state.pc;
+    if( breakpoints[pc % MEM_SIZE] && !resuming )
+    {
+        reason = StopReason::BREAKPOINT;
+        stop_pc = pc;
+        stop_addr = pc;
+        resuming = true;
+        return false;
+    }
+    resuming = false;
+
+    watch_registers = (change_watch | equal_watch) != 0;
+    if( watch_registers ) std::memcpy(before, state.reg, sizeof(before));
+    return true;
+};
+
+bool Debugger::leave(const Chip8State& state)
+{
+    if( watch_registers && reason == StopReason::NONE )
+    {
+        uint64_t after[2];
+        std::memcpy(after, state.reg, sizeof(after));
+
+        // Only looks at single registers when one of them changed.
+        if( ((before[0] ^ after[0]) | (before[1] ^ after[1])) != 0 ) checkRegisters(before, state.reg);
+    }
+
+    if( reason != StopReason::NONE )
+    {
+        stop_pc = pc;
+        return false;
+    }
+    return true;
+};
+
+void Debugger::checkRegisters(const uint64_t before[2], const uint8_t after[16])
+{
+    uint8_t old[16];
+    std::memcpy(old, before, sizeof(old));
+
+    for( uint8_t reg{0}; reg < 16 && reason == StopReason::NONE; ++reg )
+    {
+        if( old[reg] == after[reg] ) continue;
+
+        const uint16_t bit{ static_cast<uint16_t>(1 << reg) };
+        if( change_watch & bit )
+        {
+            reason = StopReason::REGISTER_CHANGE;
+            stop_addr = reg;
+        }
+        else if( (equal_watch & bit) && after[reg] == reg_values[reg] )
+        {
+            reason = StopReason::REGISTER_EQUAL;
+            stop_addr = reg;
+        }
+    }
+};
+
+StopReason Debugger::stopReason() const
+{
+    return reason;
+};
+
+uint16_t Debugger::stopPC() const
+{
+    return stop_pc;
+};
+
+uint16_t Debugger::stopAddress() const
+{
+    return stop_addr;
+};
+
+void Debugger::read(uint16_t addr, std::size_t size)
+{
+    for( std::size_t i{0}; i < size && reason == StopReason::NONE; ++i )
+    {
+        if( read_watch[(addr + i) % MEM_SIZE] )
+        {
+            reason = StopReason::WATCH_READ;
+            stop_addr = static_cast<uint16_t>((addr + i) % MEM_SIZE);
+        }
+    }
+};
+
+void Debugger::write(uint16_t addr, std::size_t size)
+{
+    for( std::size_t i{0}; i < size && reason == StopReason::NONE; ++i )
+    {
+        if( write_watch[(addr + i) % MEM_SIZE] )
+        {
+            reason = StopReason::WATCH_WRITE;
+            stop_addr = static_cast<uint16_t>((addr + i) % MEM_SIZE);
+        }
+    }
+};
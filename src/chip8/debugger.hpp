@@ -0,0 +1,92 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Declares the breakpoint and watchpoint engine. The Debugger is the Hooks
+    type of Chip8's debug interpreter loop, one per quirk profile like the
+    plain loop, and is only used while something is armed: callers switch
+    between Chip8::cycle and Debugger::run once per burst, and both work on
+    the same Chip8 with the same quirks so no state is lost.
+*/
+
+#ifndef DEBUGGER_H
+#define DEBUGGER_H
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+
+#include "state.hpp"
+
+class Chip8;
+
+enum class StopReason
+{
+    NONE,
+    BREAKPOINT,
+    WATCH_READ,
+    WATCH_WRITE,
+    REGISTER_CHANGE,
+    REGISTER_EQUAL
+};
+
+class Debugger
+{
+    private:
+        // One bit per address, so every lookup is O(1).
+        std::bitset<MEM_SIZE> breakpoints{};
+        std::bitset<MEM_SIZE> read_watch{};
+        std::bitset<MEM_SIZE> write_watch{};
+
+        // Bit n stops when Vn changes / when Vn equals reg_values[n].
+        uint16_t change_watch{};
+        uint16_t equal_watch{};
+        uint8_t reg_values[16]{};
+
+        std::size_t armed_count{};
+
+        StopReason reason{ StopReason::NONE };
+        uint16_t stop_addr{};
+        uint16_t stop_pc{};
+
+        bool resuming{};
+
+        // The instruction in flight, and V0-VF before it when any are watched.
+        uint16_t pc{};
+        bool watch_registers{};
+        uint64_t before[2]{};
+
+        void watchAccess(std::bitset<MEM_SIZE>& watch, uint16_t addr, std::size_t size, bool set);
+        void checkRegisters(const uint64_t before[2], const uint8_t after[16]);
+
+    public:
+        void setBreakpoint(uint16_t addr, bool set = true);
+        void watchRead(uint16_t addr, std::size_t size = 1, bool set = true);
+        void watchWrite(uint16_t addr, std::size_t size = 1, bool set = true);
+        void watchRegister(uint8_t reg, bool set = true);
+        void watchRegisterEqual(uint8_t reg, uint8_t value, bool set = true);
+
+        void clear();
+
+        bool armed() const;
+
+        // Runs up to count instructions and stops early on the first hit, or
+        // like Chip8::cycle after DXYN on profiles that wait for the display.
+        // Calling run() again resumes past the instruction that stopped it.
+        StopReason run(Chip8& cpu, std::size_t count);
+
+        StopReason stopReason() const;
+        // Program counter of the instruction that stopped, and the memory
+        // address or register number that triggered it.
+        uint16_t stopPC() const;
+        uint16_t stopAddress() const;
+
+        // Hooks called by Chip8::runDebug. enter() and leave() go around each
+        // instruction and return false to end the burst.
+        bool enter(const Chip8State& state);
+        bool leave(const Chip8State& state);
+        void read(uint16_t addr, std::size_t size);
+        void write(uint16_t addr, std::size_t size);
+};
+
+#endif
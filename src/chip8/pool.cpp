@@ -0,0 +1,95 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Defines the Chip8State arena.
+*/
+
+#include <cstdint>
+
+#include "pool.hpp"
+
+StatePool::StatePool(std::size_t block_size) :
+    block_size(block_size > 0 ? block_size : 1),
+    block_used(block_size > 0 ? block_size : 1)
+{};
+
+void StatePool::grow()
+{
+    blocks.emplace_back(new Chip8State[block_size]);
+    block_starts.emplace(blocks.back().get(), blocks.size() - 1);
+    acquired.resize(capacity());
+    block_used = 0;
+};
+
+Chip8State* StatePool::slotState(std::size_t slot) const
+{
+    return &blocks[slot / block_size][slot % block_size];
+};
+
+Chip8State* StatePool::acquire()
+{
+    std::size_t slot{};
+    if( !free_list.empty() )
+    {
+        slot = free_list.back();
+        free_list.pop_back();
+    }
+    else
+    {
+        if( block_used == block_size ) grow();
+        slot = (blocks.size() - 1) * block_size + block_used++;
+    }
+
+    acquired[slot] = true;
+    Chip8State *state{ slotState(slot) };
+    state->reset();
+    ++in_use;
+    return state;
+};
+
+bool StatePool::release(Chip8State* state)
+{
+    if( state == nullptr ) return false;
+
+    // The last block starting at or before the state, if it lies inside it.
+    auto block{ block_starts.upper_bound(state) };
+    if( block == block_starts.begin() ) return false;
+    --block;
+
+    // Compared as addresses, since the state may belong to no block at all.
+    const std::uintptr_t bytes{ reinterpret_cast<std::uintptr_t>(state) - reinterpret_cast<std::uintptr_t>(block->first) };
+    if( bytes % sizeof(Chip8State) != 0 || bytes / sizeof(Chip8State) >= block_size ) return false;
+
+    const std::size_t slot{ block->second * block_size + bytes / sizeof(Chip8State) };
+    if( !acquired[slot] ) return false;
+
+    acquired[slot] = false;
+    free_list.push_back(slot);
+    --in_use;
+    return true;
+};
+
+void StatePool::reserve(std::size_t count)
+{
+    while( capacity() < count )
+    {
+        // Keeps the partially used tail block reachable through the free list.
+        for( ; block_used < block_size && !blocks.empty(); ++block_used )
+        {
+            free_list.push_back((blocks.size() - 1) * block_size + block_used);
+        }
+        grow();
+    }
+    free_list.reserve(capacity());
+};
+
+std::size_t StatePool::capacity() const
+{
+    return blocks.size() * block_size;
+};
+
+std::size_t StatePool::size() const
+{
+    return in_use;
+};
@@ -0,0 +1,53 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Declares an arena that hands out Chip8State instances in bulk. States are
+    carved out of large contiguous blocks and recycled through a free list,
+    so creating or destroying an instance never touches the heap once the
+    arena is warm. Each slot has a bit saying whether it is handed out, so a
+    state released twice, or not from this pool, is refused instead of being
+    given to two owners.
+*/
+
+#ifndef POOL_H
+#define POOL_H
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "state.hpp"
+
+class StatePool
+{
+    private:
+        std::vector<std::unique_ptr<Chip8State[]>> blocks{};
+        std::vector<std::size_t> free_list{};
+
+        // Block number by start address, and one bit per slot handed out.
+        std::map<const Chip8State*, std::size_t> block_starts{};
+        std::vector<bool> acquired{};
+
+        std::size_t block_size{};
+        std::size_t block_used{};
+        std::size_t in_use{};
+
+        void grow();
+        Chip8State* slotState(std::size_t slot) const;
+
+    public:
+        StatePool(std::size_t block_size = 1024);
+
+        Chip8State* acquire();
+        // False, leaving the pool untouched, if the state is not handed out.
+        bool release(Chip8State* state);
+
+        void reserve(std::size_t count);
+
+        std::size_t capacity() const;
+        std::size_t size() const;
+};
+
+#endif
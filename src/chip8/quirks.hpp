@@ -0,0 +1,136 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Declares the compatibility quirks of the Chip8 interpreters as policy types.
+    Chip8 instantiates its interpreter loop once per policy, so every quirk is
+    resolved at compile time and the choice of profile is made once per burst
+    of instructions rather than once per instruction.
+    Behaviours follow https://chip8.gulrak.net/ and Timendus' quirks test ROM.
+*/
+
+#ifndef QUIRKS_H
+#define QUIRKS_H
+
+#include <string>
+
+enum class Profile
+{
+    DEFAULT,
+    COSMAC_VIP,
+    CHIP_48,
+    SUPER_CHIP,
+    XO_CHIP
+};
+
+// How FX55/FX65 leave index_reg behind them.
+enum class IndexIncrement
+{
+    NONE,
+    X,
+    X_PLUS_ONE
+};
+
+namespace quirks
+{
+    // The behaviour this interpreter has always had.
+    struct Default
+    {
+        static constexpr bool shift_uses_vy{true};
+        static constexpr IndexIncrement load_store{IndexIncrement::NONE};
+        static constexpr bool jump_uses_vx{false};
+        static constexpr bool draw_wraps{false};
+        static constexpr bool display_wait{false};
+        static constexpr bool logic_resets_vf{false};
+        static constexpr bool schip_opcodes{false};
+        static constexpr bool xochip_opcodes{false};
+    };
+
+    struct CosmacVip
+    {
+        static constexpr bool shift_uses_vy{true};
+        static constexpr IndexIncrement load_store{IndexIncrement::X_PLUS_ONE};
+        static constexpr bool jump_uses_vx{false};
+        static constexpr bool draw_wraps{false};
+        static constexpr bool display_wait{true};
+        static constexpr bool logic_resets_vf{true};
+        static constexpr bool schip_opcodes{false};
+        static constexpr bool xochip_opcodes{false};
+    };
+
+    struct Chip48
+    {
+        static constexpr bool shift_uses_vy{false};
+        static constexpr IndexIncrement load_store{IndexIncrement::X};
+        static constexpr bool jump_uses_vx{true};
+        static constexpr bool draw_wraps{false};
+        static constexpr bool display_wait{false};
+        static constexpr bool logic_resets_vf{false};
+        static constexpr bool schip_opcodes{false};
+        static constexpr bool xochip_opcodes{false};
+    };
+
+    struct SuperChip
+    {
+        static constexpr bool shift_uses_vy{false};
+        static constexpr IndexIncrement load_store{IndexIncrement::NONE};
+        static constexpr bool jump_uses_vx{true};
+        static constexpr bool draw_wraps{false};
+        static constexpr bool display_wait{false};
+        static constexpr bool logic_resets_vf{false};
+        static constexpr bool schip_opcodes{true};
+        static constexpr bool xochip_opcodes{false};
+    };
+
+    struct XoChip
+    {
+        static constexpr bool shift_uses_vy{true};
+        static constexpr IndexIncrement load_store{IndexIncrement::X_PLUS_ONE};
+        static constexpr bool jump_uses_vx{false};
+        static constexpr bool draw_wraps{true};
+        static constexpr bool display_wait{false};
+        static constexpr bool logic_resets_vf{false};
+        static constexpr bool schip_opcodes{true};
+        static constexpr bool xochip_opcodes{true};
+    };
+}
+
+// The schip_opcodes quirk of a profile chosen at runtime.
+inline bool hasSchipOpcodes(Profile profile)
+{
+    switch(profile)
+    {
+        case Profile::COSMAC_VIP:   return quirks::CosmacVip::schip_opcodes;
+        case Profile::CHIP_48:      return quirks::Chip48::schip_opcodes;
+        case Profile::SUPER_CHIP:   return quirks::SuperChip::schip_opcodes;
+        case Profile::XO_CHIP:      return quirks::XoChip::schip_opcodes;
+        default:                    return quirks::Default::schip_opcodes;
+    }
+}
+
+// Accepts "default", "vip", "chip48", "schip" and "xochip".
+inline bool profileFromName(const std::string& name, Profile& profile)
+{
+    if( name == "default" )     profile = Profile::DEFAULT;
+    else if( name == "vip" )    profile = Profile::COSMAC_VIP;
+    else if( name == "chip48" ) profile = Profile::CHIP_48;
+    else if( name == "schip" )  profile = Profile::SUPER_CHIP;
+    else if( name == "xochip" ) profile = Profile::XO_CHIP;
+    else return false;
+
+    return true;
+}
+
+inline const char* profileName(Profile profile)
+{
+    switch(profile)
+    {
+        case Profile::COSMAC_VIP:   return "vip";
+        case Profile::CHIP_48:      return "chip48";
+        case Profile::SUPER_CHIP:   return "schip";
+        case Profile::XO_CHIP:      return "xochip";
+        default:                    return "default";
+    }
+}
+
+#endif
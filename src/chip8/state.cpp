@@ -0,0 +1,70 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Defines the reset behaviour of the compact Chip8 state.
+*/
+
+#include <algorithm>
+
+#include "header.hpp"
+#include "hash.hpp"
+#include "state.hpp"
+
+void Chip8State::reset()
+{
+    pc = MEM_ADDR_START;
+    index_reg = 0;
+    sp = 0;
+    delay = 0;
+    sound = 0;
+    planes = 1;
+
+    std::fill(std::begin( reg ), std::end( reg ), 0);
+    std::fill(std::begin( stack ), std::end( stack ), 0);
+    std::fill(std::begin( flags ), std::end( flags ), 0);
+    memory.fill(0);
+
+    const uint8_t sprite_data[HEX_SPRITE_LENGTH]{HEX_SPRITE_DATA};
+    std::copy(std::begin( sprite_data ), std::end( sprite_data ), memory.begin() + ADDR_SPRITE);
+
+    rehashMemory();
+};
+
+void Chip8State::setBigFont(bool loaded)
+{
+    const uint8_t big_sprite_data[BIG_HEX_SPRITE_LENGTH]{BIG_HEX_SPRITE_DATA};
+    for( uint16_t i{0}; i < BIG_HEX_SPRITE_LENGTH; ++i )
+    {
+        write(ADDR_BIG_SPRITE + i, loaded ? big_sprite_data[i] : 0);
+    }
+};
+
+void Chip8State::rehashMemory()
+{
+    std::copy_n(memory.begin(), MEM_GUARD, memory.begin() + MEM_SIZE);
+    memory_hash = hashMemory(memory.data(), MEM_SIZE);
+};
+
+uint64_t Chip8State::hash() const
+{
+    uint64_t hash{ mixHash(memory_hash ^ (static_cast<uint64_t>(pc) << 48)
+        ^ (static_cast<uint64_t>(index_reg) << 32) ^ (planes << 24) ^ (sp << 16) ^ (delay << 8) ^ sound) };
+
+    for( const uint8_t* bytes : { reg, flags } )
+    {
+        for( std::size_t i{0}; i < 16; i += 8 )
+        {
+            uint64_t word{0};
+            for( std::size_t j{0}; j < 8; ++j ) word = (word << 8) | bytes[i + j];
+            hash = mixHash(hash ^ word);
+        }
+    }
+    for( std::size_t i{0}; i < 16; i += 4 )
+    {
+        const uint64_t word{ (static_cast<uint64_t>(stack[i]) << 48) | (static_cast<uint64_t>(stack[i + 1]) << 32)
+            | (static_cast<uint64_t>(stack[i + 2]) << 16) | stack[i + 3] };
+        hash = mixHash(hash ^ word);
+    }
+    return hash;
+};
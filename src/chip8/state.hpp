@@ -0,0 +1,110 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Declares the compact core state of a Chip8 system. The state is trivially
+    copyable and owns no resources, so instances can be created, copied and
+    recycled in bulk without touching the heap or the file system.
+
+    Memory is a 12-bit address space. The accessors mask every address, and
+    the allocation carries MEM_GUARD bytes past 0xFFF that mirror the first
+    MEM_GUARD bytes of memory. A multi-byte read such as a DXYN sprite can
+    therefore take a pointer from span() and run up to MEM_GUARD bytes on,
+    wrapping around exactly as the masked addresses would, with no check.
+*/
+
+#ifndef STATE_H
+#define STATE_H
+
+#define MEM_ADDR_START 0x200
+#define MEM_ADDR_END 0xE8F
+
+#define MEM_SIZE 4096
+#define MEM_MASK (MEM_SIZE - 1)
+
+// The longest run one instruction reads: a 16x16 sprite on both XO-CHIP planes.
+#define MEM_GUARD 64
+
+#define ADDR_SPRITE 0x000
+#define ADDR_BIG_SPRITE 0x050
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+#include "hash.hpp"
+
+// Registers are grouped at the front so that everything execute() touches on
+// most instructions shares the first cache line; memory follows.
+struct alignas(64) Chip8State
+{
+    uint16_t pc{ MEM_ADDR_START };
+    uint16_t index_reg{};
+
+    uint8_t reg[16]{};
+
+    uint8_t sp{};
+    uint8_t delay{};
+    uint8_t sound{};
+
+    // XO-CHIP bitplanes selected by FN01, plane 0 is the CHIP-8 screen.
+    uint8_t planes{1};
+
+    uint16_t stack[16]{};
+
+    // SUPER-CHIP RPL user flags saved and restored by FX75/FX85.
+    uint8_t flags[16]{};
+
+    // Kept in step with memory by write(), see hash.hpp.
+    uint64_t memory_hash{};
+
+    // MEM_SIZE bytes of memory, then the guard.
+    std::array<uint8_t, MEM_SIZE + MEM_GUARD> memory{};
+
+    // Leaves the big font out; see setBigFont().
+    void reset();
+
+    // Writes the SUPER-CHIP big font at ADDR_BIG_SPRITE, or zeroes it.
+    void setBigFont(bool loaded);
+
+    uint8_t read(uint16_t addr) const;
+    const uint8_t* span(uint16_t addr) const;
+
+    // Keeps memory_hash and the guard in step with the byte written.
+    void write(uint16_t addr, uint8_t value);
+
+    // After memory is changed without write(), recomputes memory_hash and
+    // the guard from the first MEM_SIZE bytes.
+    void rehashMemory();
+
+    // Combines memory_hash with the registers, timers, stack and flags in O(1).
+    uint64_t hash() const;
+};
+
+static_assert((MEM_SIZE & MEM_MASK) == 0, "MEM_SIZE must be a power of two for masking");
+static_assert(MEM_GUARD <= ADDR_BIG_SPRITE, "The guard mirrors only the small font");
+
+inline uint8_t Chip8State::read(uint16_t addr) const
+{
+    return memory[addr & MEM_MASK];
+}
+
+inline const uint8_t* Chip8State::span(uint16_t addr) const
+{
+    return memory.data() + (addr & MEM_MASK);
+}
+
+inline void Chip8State::write(uint16_t addr, uint8_t value)
+{
+    addr &= MEM_MASK;
+    memory_hash ^= memoryKey(addr, memory[addr]) ^ memoryKey(addr, value);
+    memory[addr] = value;
+
+    // Only the font area is mirrored, so this is almost never taken.
+    if( addr < MEM_GUARD ) memory[addr + MEM_SIZE] = value;
+}
+
+static_assert(std::is_trivially_copyable<Chip8State>::value, "Chip8State must stay trivially copyable");
+static_assert(std::is_standard_layout<Chip8State>::value, "Chip8State must stay standard layout");
+
+#endif
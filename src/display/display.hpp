@@ -2,36 +2,38 @@
     Author: Min Kang
     Creation Date: January 11th, 2024
 
-    Declares behaviors of the game display. Acts as a abstraction to the 
-    SDL renderer functions.
+    Declares the SDL presenter of the game display. Converts a Framebuffer
+    into the texture and acts as a abstraction to the SDL renderer functions.
 */
 #ifndef DISPLAY_H
 #define DISPLAY_H
 
 #include <SDL2/SDL_render.h>
 
+#include <array>
+
 #include "header.hpp"
-#include "logger.hpp"
-#include "bus.hpp"
+#include "framebuffer.hpp"
 
-class Display : public Component
+class Display
 {
     private:
-        uint32_t off_pixel{};
-        uint32_t on_pixel{};
+        std::array<uint32_t, COLOURS> palette{};
 
-        uint32_t *buffer{ new uint32_t[WIDTH*HEIGHT]{} };
+        // Sized for hires so switching mode never reallocates; the texture is
+        // HIRES_WIDTH x HIRES_HEIGHT and only the active corner is shown.
+        std::array<uint32_t, HIRES_WIDTH*HIRES_HEIGHT> buffer{};
 
         SDL_Texture* texture{};
 
     public:
-        Display(Bus& bus, SDL_Texture* texture, uint32_t off_pixel, uint32_t on_pixel);
+        Display(SDL_Texture* texture, const std::array<uint32_t, COLOURS>& palette);
         ~Display();
 
-        bool drawPixelData(uint16_t x_pos, uint16_t y_pos, uint8_t data[], std::size_t size);
+        Display(const Display&) = delete;
+        Display& operator=(const Display&) = delete;
 
-        void clearScreen();
-        void updateScreen(SDL_Renderer* renderer);
+        void updateScreen(const Framebuffer& framebuffer, SDL_Renderer* renderer);
 };
 
-#endif
\ No newline at end of file
+#endif
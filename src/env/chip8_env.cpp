@@ -0,0 +1,63 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Defines the C interface over VecEnv.
+*/
+
+#include "chip8_env.h"
+#include "env.hpp"
+
+static_assert(CHIP8_ENV_FRAME_SIZE == ENV_FRAME_SIZE, "C frame size must match VecEnv");
+
+struct chip8_env
+{
+    VecEnv env;
+
+    chip8_env(size_t count, size_t frames_per_step, size_t threads, uint64_t seed, uint32_t max_frames) :
+        env(count, frames_per_step, threads, seed, max_frames)
+    {};
+};
+
+chip8_env* chip8_env_create(size_t count, size_t frames_per_step, size_t threads,
+    uint64_t seed, uint32_t max_frames)
+{
+    try
+    {
+        return new chip8_env(count, frames_per_step, threads, seed, max_frames);
+    }
+    catch(...)
+    {
+        return nullptr;
+    }
+}
+
+void chip8_env_destroy(chip8_env* env)
+{
+    delete env;
+}
+
+int chip8_env_load(chip8_env* env, const uint8_t* rom, size_t size)
+{
+    return env->env.loadProgram(rom, size) ? 0 : -1;
+}
+
+void chip8_env_reset(chip8_env* env)
+{
+    env->env.reset();
+}
+
+int chip8_env_reset_one(chip8_env* env, size_t index)
+{
+    return env->env.reset(index) ? 0 : -1;
+}
+
+void chip8_env_step(chip8_env* env, const uint16_t* actions, uint8_t* frames, uint8_t* done)
+{
+    env->env.step(actions, frames, done);
+}
+
+size_t chip8_env_size(const chip8_env* env)
+{
+    return env->env.size();
+}
@@ -0,0 +1,43 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Declares a thin C interface over VecEnv for bindings from other languages.
+    Frames are CHIP8_ENV_FRAME_SIZE bytes per instance, one byte per 64x32 pixel.
+*/
+
+#ifndef CHIP8_ENV_H
+#define CHIP8_ENV_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define CHIP8_ENV_FRAME_SIZE (64*32)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct chip8_env chip8_env;
+
+chip8_env* chip8_env_create(size_t count, size_t frames_per_step, size_t threads,
+    uint64_t seed, uint32_t max_frames);
+void chip8_env_destroy(chip8_env* env);
+
+/* Returns 0 on success, -1 if the ROM does not fit in memory. */
+int chip8_env_load(chip8_env* env, const uint8_t* rom, size_t size);
+
+void chip8_env_reset(chip8_env* env);
+
+/* Returns 0 on success, -1 if index is not below chip8_env_size(). */
+int chip8_env_reset_one(chip8_env* env, size_t index);
+
+void chip8_env_step(chip8_env* env, const uint16_t* actions, uint8_t* frames, uint8_t* done);
+
+size_t chip8_env_size(const chip8_env* env);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
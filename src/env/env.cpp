@@ -0,0 +1,184 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Defines the batched, headless environment.
+*/
+
+#include <algorithm>
+
+#include "env.hpp"
+#include "hash.hpp"
+
+EnvInstance::EnvInstance(uint64_t seed) :
+    cpu(*this),
+    random(seed)
+{};
+
+void EnvInstance::notify(EventData event)
+{
+    switch(event.type)
+    {
+        case EventType::DISPLAY_CLEAR:
+            framebuffer.clearScreen(event.planes);
+            break;
+        case EventType::DISPLAY_DRAW:
+            cpu.setStatusReg(
+                framebuffer.drawPixelData(
+                    event.draw.xpos,
+                    event.draw.ypos,
+                    event.draw.data,
+                    event.draw.size,
+                    event.draw.wrap,
+                    event.draw.wide,
+                    event.draw.planes
+                )
+            );
+            break;
+        case EventType::DISPLAY_SCROLL:
+            framebuffer.scroll(event.scroll.dx, event.scroll.dy, event.scroll.planes);
+            break;
+        case EventType::DISPLAY_MODE:
+            framebuffer.setHires(event.hires);
+            break;
+        case EventType::KEYBOARD_GET:
+            // The core reads one key at a time, so the lowest held key wins.
+            *event.key = (keys == 0) ? KEY_NOTPRESSED : static_cast<uint8_t>(__builtin_ctz(keys));
+            break;
+        case EventType::RANDOM:
+            *event.random.dest = event.random.mask & random.next();
+            break;
+    }
+};
+
+void EnvInstance::reset(const uint8_t rom[], std::size_t size, Profile profile)
+{
+    cpu.reset();
+    cpu.setProfile(profile);
+    cpu.loadData(MEM_ADDR_START, rom, static_cast<int>(size));
+
+    // Also clears, and leaves the hires mode of the last episode.
+    framebuffer.setHires(false);
+    keys = 0;
+    frame = 0;
+    done = false;
+};
+
+void EnvInstance::advance(uint16_t keys, std::size_t frames, uint32_t max_frames)
+{
+    this->keys = keys;
+
+    for( std::size_t i{0}; i < frames && !done; ++i )
+    {
+        cpu.cycle(INSTR_PER_FRAME);
+        cpu.tickTimer();
+
+        // A jump onto itself is how ROMs halt, SUPER-CHIP ones may also exit;
+        // other profiles skip 00FD.
+        const uint16_t opcode{ cpu.fetch() };
+        done = ((opcode & 0xF000) == 0x1000 && (opcode & 0x0FFF) == cpu.getState().pc)
+            || (opcode == 0x00FD && hasSchipOpcodes(cpu.getProfile()));
+        done = done || (max_frames > 0 && ++frame >= max_frames);
+    }
+};
+
+void EnvInstance::writeFrame(uint8_t out[]) const
+{
+    framebuffer.renderLores(out);
+};
+
+bool EnvInstance::isDone() const
+{
+    return done;
+};
+
+uint64_t EnvInstance::hash() const
+{
+    return mixHash(cpu.hash() ^ framebuffer.hash());
+};
+
+VecEnv::VecEnv(std::size_t count, std::size_t frames_per_step, std::size_t threads,
+    uint64_t seed, uint32_t max_frames) :
+    workers(std::min(threads == 0 ? std::max(std::thread::hardware_concurrency(), 1u) : threads,
+        std::max<std::size_t>(count, 1))),
+    frames_per_step(frames_per_step),
+    max_frames(max_frames)
+{
+    instances.reserve(count);
+    for( std::size_t i{0}; i < count; ++i )
+    {
+        instances.emplace_back(new EnvInstance(seed + i));
+    }
+};
+
+bool VecEnv::loadProgram(const uint8_t rom[], std::size_t size, Profile profile)
+{
+    if( size > MEM_ADDR_END - MEM_ADDR_START ) return false;
+
+    this->rom.assign(rom, rom + size);
+    this->profile = profile;
+    reset();
+    return true;
+};
+
+void VecEnv::reset()
+{
+    for( std::size_t i{0}; i < instances.size(); ++i ) reset(i);
+};
+
+bool VecEnv::reset(std::size_t index)
+{
+    if( index >= instances.size() ) return false;
+
+    instances[index]->reset(rom.data(), rom.size(), profile);
+    return true;
+};
+
+void VecEnv::stepSlice(void *context, std::size_t begin, std::size_t end)
+{
+    VecEnv& env{ *static_cast<VecEnv*>(context) };
+
+    for( std::size_t i{begin}; i < end; ++i )
+    {
+        EnvInstance& instance{ *env.instances[i] };
+
+        instance.advance(env.actions[i], env.frames_per_step, env.max_frames);
+        instance.writeFrame(env.frames + i*ENV_FRAME_SIZE);
+        env.done[i] = instance.isDone();
+
+        if( env.table != nullptr ) env.novel[i] = env.table->insert(instance.hash());
+    }
+};
+
+void VecEnv::step(const uint16_t actions[], uint8_t frames[], uint8_t done[])
+{
+    this->actions = actions;
+    this->frames = frames;
+    this->done = done;
+    this->table = nullptr;
+    this->novel = nullptr;
+
+    workers.dispatch(&VecEnv::stepSlice, this, instances.size());
+};
+
+void VecEnv::step(const uint16_t actions[], uint8_t frames[], uint8_t done[],
+    TranspositionTable& table, uint8_t novel[])
+{
+    this->actions = actions;
+    this->frames = frames;
+    this->done = done;
+    this->table = &table;
+    this->novel = novel;
+
+    workers.dispatch(&VecEnv::stepSlice, this, instances.size());
+};
+
+uint64_t VecEnv::hash(std::size_t index) const
+{
+    return instances[index]->hash();
+};
+
+std::size_t VecEnv::size() const
+{
+    return instances.size();
+};
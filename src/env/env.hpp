@@ -0,0 +1,111 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Declares a batched, headless environment for training loops. VecEnv owns
+    N Chip8 instances, applies one key mask per instance and advances all of
+    them in a single step() call, spread across a fixed worker pool.
+*/
+
+#ifndef ENV_H
+#define ENV_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "header.hpp"
+#include "random.hpp"
+#include "bus.hpp"
+#include "chip8.hpp"
+#include "framebuffer.hpp"
+#include "transposition.hpp"
+#include "workers.hpp"
+
+// One byte per lores pixel holding its colour index (0 or 1 unless XO-CHIP
+// planes are used), row major. Hires screens are pooled down, see
+// Framebuffer::renderLores.
+#define ENV_FRAME_SIZE (WIDTH*HEIGHT)
+
+class EnvInstance : public Bus
+{
+    private:
+        Chip8 cpu;
+
+        Framebuffer framebuffer{};
+
+        Random random;
+        uint16_t keys{};
+
+        uint32_t frame{};
+        bool done{};
+
+    public:
+        EnvInstance(uint64_t seed);
+
+        void notify(EventData event);
+
+        void reset(const uint8_t rom[], std::size_t size, Profile profile);
+
+        // Runs the given number of frames with the key mask held down.
+        // Bit n of keys holds key n.
+        void advance(uint16_t keys, std::size_t frames, uint32_t max_frames);
+
+        void writeFrame(uint8_t out[]) const;
+
+        bool isDone() const;
+
+        // Identifies the CPU state and framebuffer, see hash.hpp.
+        uint64_t hash() const;
+};
+
+class VecEnv
+{
+    private:
+        std::vector<std::unique_ptr<EnvInstance>> instances{};
+        WorkerPool workers;
+
+        std::vector<uint8_t> rom{};
+        Profile profile{};
+
+        std::size_t frames_per_step{};
+        uint32_t max_frames{};
+
+        const uint16_t *actions{};
+        uint8_t *frames{};
+        uint8_t *done{};
+
+        TranspositionTable *table{};
+        uint8_t *novel{};
+
+        static void stepSlice(void *context, std::size_t begin, std::size_t end);
+
+    public:
+        // threads = 0 uses every hardware thread, max_frames = 0 never ends an
+        // episode on length alone.
+        VecEnv(std::size_t count, std::size_t frames_per_step = 1, std::size_t threads = 0,
+            uint64_t seed = 0, uint32_t max_frames = 0);
+
+        bool loadProgram(const uint8_t rom[], std::size_t size, Profile profile = Profile::DEFAULT);
+
+        void reset();
+
+        // False if index is not an instance.
+        bool reset(std::size_t index);
+
+        // actions[N] key masks in, frames[N * ENV_FRAME_SIZE] and done[N] out.
+        // Writes straight into the caller's buffers, nothing is allocated.
+        void step(const uint16_t actions[], uint8_t frames[], uint8_t done[]);
+
+        // Same as step(), and also inserts every resulting state into table.
+        // novel[i] is 1 if instance i reached a state the table had not seen.
+        void step(const uint16_t actions[], uint8_t frames[], uint8_t done[],
+            TranspositionTable& table, uint8_t novel[]);
+
+        uint64_t hash(std::size_t index) const;
+
+        std::size_t size() const;
+};
+
+#endif
@@ -0,0 +1,82 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Defines the lock-free transposition table. Open addressing with linear
+    probing; 0 marks an empty slot, so a hash of 0 is stored as 1.
+*/
+
+#include "transposition.hpp"
+
+// Stops probing well before the table is completely full.
+#define MAX_PROBE 64
+
+TranspositionTable::TranspositionTable(std::size_t capacity)
+{
+    std::size_t size{1};
+    while( size < capacity ) size <<= 1;
+
+    slots.reset(new std::atomic<uint64_t>[size]);
+    mask = size - 1;
+    clear();
+};
+
+bool TranspositionTable::insert(uint64_t hash)
+{
+    hash += (hash == 0);
+
+    std::size_t index{ static_cast<std::size_t>(hash) & mask };
+    for( std::size_t probe{0}; probe < MAX_PROBE; ++probe )
+    {
+        uint64_t expected{0};
+        if( slots[index].compare_exchange_strong(expected, hash, std::memory_order_relaxed) )
+        {
+            count.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        if( expected == hash ) return false;
+
+        index = (index + 1) & mask;
+    }
+
+    overflow.fetch_add(1, std::memory_order_relaxed);
+    return true;
+};
+
+bool TranspositionTable::contains(uint64_t hash) const
+{
+    hash += (hash == 0);
+
+    std::size_t index{ static_cast<std::size_t>(hash) & mask };
+    for( std::size_t probe{0}; probe < MAX_PROBE; ++probe )
+    {
+        const uint64_t slot{ slots[index].load(std::memory_order_relaxed) };
+        if( slot == hash ) return true;
+        if( slot == 0 ) return false;
+
+        index = (index + 1) & mask;
+    }
+    return false;
+};
+
+void TranspositionTable::clear()
+{
+    for( std::size_t i{0}; i <= mask; ++i ) slots[i].store(0, std::memory_order_relaxed);
+    count = 0;
+    overflow = 0;
+};
+
+std::size_t TranspositionTable::size() const
+{
+    return count.load(std::memory_order_relaxed);
+};
+
+std::size_t TranspositionTable::capacity() const
+{
+    return mask + 1;
+};
+
+std::size_t TranspositionTable::overflowed() const
+{
+    return overflow.load(std::memory_order_relaxed);
+};
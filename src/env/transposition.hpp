@@ -0,0 +1,42 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Declares a fixed size, lock-free set of 64-bit state hashes. Workers of a
+    batch insert concurrently to find out whether a state was seen before.
+*/
+
+#ifndef TRANSPOSITION_H
+#define TRANSPOSITION_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+class TranspositionTable
+{
+    private:
+        std::unique_ptr<std::atomic<uint64_t>[]> slots{};
+        std::size_t mask{};
+
+        std::atomic<std::size_t> count{};
+        std::atomic<std::size_t> overflow{};
+
+    public:
+        // Capacity is rounded up to a power of two.
+        TranspositionTable(std::size_t capacity);
+
+        // Returns true the first time a hash is inserted. Once the table is
+        // full every unseen hash is reported as new and counted as overflow.
+        bool insert(uint64_t hash);
+        bool contains(uint64_t hash) const;
+
+        void clear();
+
+        std::size_t size() const;
+        std::size_t capacity() const;
+        std::size_t overflowed() const;
+};
+
+#endif
@@ -0,0 +1,88 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Defines the fixed worker pool.
+*/
+
+#include "workers.hpp"
+
+WorkerPool::WorkerPool(std::size_t thread_count)
+{
+    if( thread_count == 0 ) thread_count = std::thread::hardware_concurrency();
+    if( thread_count == 0 ) thread_count = 1;
+
+    // Slice 0 belongs to the dispatching thread.
+    for( std::size_t slice{1}; slice < thread_count; ++slice )
+    {
+        threads.emplace_back(&WorkerPool::workerLoop, this, slice);
+    }
+};
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        stopping = true;
+    }
+    start_cv.notify_all();
+
+    for( std::thread& thread : threads ) thread.join();
+};
+
+std::size_t WorkerPool::size() const
+{
+    return threads.size() + 1;
+};
+
+void WorkerPool::runSlice(std::size_t slice)
+{
+    const std::size_t slices{ size() };
+    const std::size_t begin{ count * slice / slices };
+    const std::size_t end{ count * (slice + 1) / slices };
+
+    if( begin < end ) job(context, begin, end);
+};
+
+void WorkerPool::workerLoop(std::size_t slice)
+{
+    uint64_t seen{0};
+    while( true )
+    {
+        {
+            std::unique_lock<std::mutex> lock{mutex};
+            start_cv.wait(lock, [&]{ return stopping || generation != seen; });
+            if( stopping ) return;
+            seen = generation;
+        }
+
+        runSlice(slice);
+
+        std::lock_guard<std::mutex> lock{mutex};
+        if( --pending == 0 ) done_cv.notify_one();
+    }
+};
+
+void WorkerPool::dispatch(Job job, void *context, std::size_t count)
+{
+    if( threads.empty() )
+    {
+        if( count > 0 ) job(context, 0, count);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        this->job = job;
+        this->context = context;
+        this->count = count;
+        pending = threads.size();
+        ++generation;
+    }
+    start_cv.notify_all();
+
+    runSlice(0);
+
+    std::unique_lock<std::mutex> lock{mutex};
+    done_cv.wait(lock, [&]{ return pending == 0; });
+};
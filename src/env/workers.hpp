@@ -0,0 +1,57 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Declares a fixed pool of worker threads that splits a range of indices
+    into one contiguous slice per thread. Threads are created once and parked
+    between dispatches, so a dispatch neither spawns threads nor allocates.
+*/
+
+#ifndef WORKERS_H
+#define WORKERS_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorkerPool
+{
+    public:
+        using Job = void (*)(void *context, std::size_t begin, std::size_t end);
+
+    private:
+        std::vector<std::thread> threads{};
+
+        std::mutex mutex{};
+        std::condition_variable start_cv{};
+        std::condition_variable done_cv{};
+
+        Job job{};
+        void *context{};
+        std::size_t count{};
+
+        uint64_t generation{};
+        std::size_t pending{};
+        bool stopping{};
+
+        void runSlice(std::size_t slice);
+        void workerLoop(std::size_t slice);
+
+    public:
+        WorkerPool(std::size_t thread_count = 0);
+        ~WorkerPool();
+
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+        // Runs job over [0, count) and returns once every slice has finished.
+        // The calling thread works on the first slice.
+        void dispatch(Job job, void *context, std::size_t count);
+
+        std::size_t size() const;
+};
+
+#endif
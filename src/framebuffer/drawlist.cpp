@@ -0,0 +1,107 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Defines the deferred draw list.
+*/
+
+#include "drawlist.hpp"
+
+DrawList::DrawList()
+{
+    shadow.setHashing(false);
+};
+
+void DrawList::reset(const Framebuffer& target)
+{
+    shadow.assign(target);
+    commands.clear();
+    bytes.clear();
+};
+
+void DrawList::setRecording(bool enabled)
+{
+    recording = enabled;
+    commands.clear();
+    bytes.clear();
+};
+
+bool DrawList::drawPixelData(uint16_t x_pos, uint16_t y_pos, const uint8_t data[], std::size_t rows,
+    bool wrap, bool wide, uint8_t plane_mask)
+{
+    if( !recording ) return shadow.drawPixelData(x_pos, y_pos, data, rows, wrap, wide, plane_mask);
+
+    // Memory may change before the frame is presented, so the bytes are copied.
+    const std::size_t size{ rows * (wide ? 2 : 1) * __builtin_popcount(plane_mask & ALL_PLANES) };
+    commands.push_back({
+        .op = DrawOp::DRAW,
+        .planes = plane_mask,
+        .x = static_cast<int16_t>(x_pos),
+        .y = static_cast<int16_t>(y_pos),
+        .rows = static_cast<uint8_t>(rows),
+        .wrap = wrap,
+        .wide = wide,
+        .data = static_cast<uint32_t>(bytes.size())
+    });
+    bytes.insert(bytes.end(), data, data + size);
+
+    return shadow.drawPixelData(x_pos, y_pos, data, rows, wrap, wide, plane_mask);
+};
+
+void DrawList::clearScreen(uint8_t plane_mask)
+{
+    if( recording ) commands.push_back({ .op = DrawOp::CLEAR, .planes = plane_mask });
+    shadow.clearScreen(plane_mask);
+};
+
+void DrawList::scroll(int dx, int dy, uint8_t plane_mask)
+{
+    if( recording ) commands.push_back({ .op = DrawOp::SCROLL, .planes = plane_mask, .x = static_cast<int16_t>(dx), .y = static_cast<int16_t>(dy) });
+    shadow.scroll(dx, dy, plane_mask);
+};
+
+void DrawList::setHires(bool hires)
+{
+    if( recording ) commands.push_back({ .op = DrawOp::MODE, .hires = hires });
+    shadow.setHires(hires);
+};
+
+const Framebuffer& DrawList::getShadow() const
+{
+    return shadow;
+};
+
+const std::vector<DrawCommand>& DrawList::getCommands() const
+{
+    return commands;
+};
+
+void DrawList::replay(Framebuffer& target) const
+{
+    for( const DrawCommand& command : commands )
+    {
+        switch( command.op )
+        {
+            case DrawOp::CLEAR:
+                target.clearScreen(command.planes);
+                break;
+            case DrawOp::DRAW:
+                target.drawPixelData(static_cast<uint16_t>(command.x), static_cast<uint16_t>(command.y),
+                    bytes.data() + command.data, command.rows, command.wrap, command.wide, command.planes);
+                break;
+            case DrawOp::SCROLL:
+                target.scroll(command.x, command.y, command.planes);
+                break;
+            case DrawOp::MODE:
+                target.setHires(command.hires);
+                break;
+        }
+    }
+};
+
+void DrawList::present(Framebuffer& target)
+{
+    target.assign(shadow);
+    commands.clear();
+    bytes.clear();
+};
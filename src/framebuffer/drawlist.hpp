@@ -0,0 +1,91 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Declares the deferred draw list. The bus hands it a frame's clears,
+    draws, scrolls and mode switches instead of applying them to the
+    framebuffer one event at a time. Each is applied straight away to a
+    shadow framebuffer that skips hashing, so DXYN still gets its collision
+    flag at the point of the draw, and recorded with a copy of its sprite
+    bytes. When the frame is presented the framebuffer takes the shadow's
+    words in one pass and hashes only the pixels that changed over the whole
+    frame; sprites erased and redrawn in place cost nothing there.
+
+    Recording the commands is for presenters that keep their own framebuffer,
+    on another thread for instance, and replay a frame onto it. Without one,
+    recording can be turned off to save copying the sprite bytes.
+*/
+
+#ifndef DRAWLIST_H
+#define DRAWLIST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "framebuffer.hpp"
+
+enum class DrawOp : uint8_t
+{
+    CLEAR,
+    DRAW,
+    SCROLL,
+    MODE
+};
+
+struct DrawCommand
+{
+    DrawOp op{};
+    uint8_t planes{};
+
+    // DRAW: the position, rows and flags of drawPixelData, the sprite bytes
+    // starting at data in the list's byte pool. SCROLL: dx, dy in x, y.
+    int16_t x{};
+    int16_t y{};
+    uint8_t rows{};
+    bool wrap{};
+    bool wide{};
+
+    // MODE: the new mode.
+    bool hires{};
+
+    uint32_t data{};
+};
+
+class DrawList
+{
+    private:
+        Framebuffer shadow{};
+
+        std::vector<DrawCommand> commands{};
+        std::vector<uint8_t> bytes{};
+        bool recording{true};
+
+    public:
+        DrawList();
+
+        // Starts over from the pixels of target, dropping pending commands.
+        void reset(const Framebuffer& target);
+
+        void setRecording(bool enabled);
+
+        // Same arguments and results as the Framebuffer calls they defer.
+        bool drawPixelData(uint16_t x_pos, uint16_t y_pos, const uint8_t data[], std::size_t rows,
+            bool wrap = false, bool wide = false, uint8_t plane_mask = 1);
+        void clearScreen(uint8_t plane_mask = ALL_PLANES);
+        void scroll(int dx, int dy, uint8_t plane_mask = ALL_PLANES);
+        void setHires(bool hires);
+
+        // The screen as the commands so far leave it.
+        const Framebuffer& getShadow() const;
+        const std::vector<DrawCommand>& getCommands() const;
+
+        // Applies the recorded commands to target in order, which should
+        // show what the shadow started from.
+        void replay(Framebuffer& target) const;
+
+        // Brings target up to the shadow and starts the next frame.
+        void present(Framebuffer& target);
+};
+
+#endif
@@ -0,0 +1,334 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Defines the pure C++ framebuffer.
+*/
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "framebuffer.hpp"
+#include "hash.hpp"
+
+#define PLANE_PIXELS (HIRES_WIDTH*HIRES_HEIGHT)
+#define HIRES_KEY pixelKey(PLANES*PLANE_PIXELS)
+
+// Returns the bits of a sprite row, aligned to the most significant bit, that
+// land in a word starting shift pixels to the left of the sprite.
+inline uint64_t placeBits(uint64_t sprite, int shift)
+{
+    if( shift >= 64 || shift <= -64 ) return 0;
+    return (shift >= 0) ? sprite >> shift : sprite << -shift;
+}
+
+bool Framebuffer::drawPixelData(uint16_t x_pos, uint16_t y_pos, const uint8_t data[], std::size_t rows,
+    bool wrap, bool wide, uint8_t plane_mask)
+{
+    bool set_to_unset{false};
+    for( std::size_t p{0}; p < PLANES; ++p )
+    {
+        if( (plane_mask & (1 << p)) == 0 ) continue;
+
+        set_to_unset |= wrap ? drawRows<true>(planes[p], p, x_pos, y_pos, data, rows, wide)
+                             : drawRows<false>(planes[p], p, x_pos, y_pos, data, rows, wide);
+        data += wide ? 2*rows : rows;
+    }
+    return set_to_unset;
+};
+
+template<bool Wrap>
+bool Framebuffer::drawRows(Plane& plane, std::size_t p, uint16_t x_pos, uint16_t y_pos,
+    const uint8_t data[], std::size_t rows, bool wide)
+{
+    const int row_width{ static_cast<int>(width()) };
+    const std::size_t row_count{ height() };
+    const std::size_t words{ hires ? ROW_WORDS : 1u };
+
+    x_pos %= row_width;
+    y_pos %= row_count;
+
+    bool set_to_unset{false};
+    for( std::size_t r{0}; r < rows && (Wrap || y_pos + r < row_count); ++r )
+    {
+        const std::size_t y{ Wrap ? (y_pos + r) % row_count : y_pos + r };
+        const uint64_t sprite{ wide
+            ? (static_cast<uint64_t>(data[2*r]) << 56) | (static_cast<uint64_t>(data[2*r + 1]) << 48)
+            : static_cast<uint64_t>(data[r]) << 56 };
+
+        for( std::size_t w{0}; w < words; ++w )
+        {
+            // Placing the sprite a second time one row width to the left
+            // carries whatever crossed the right edge over to x = 0.
+            const int shift{ x_pos - 64*static_cast<int>(w) };
+            const uint64_t bits{ placeBits(sprite, shift) | (Wrap ? placeBits(sprite, shift - row_width) : 0) };
+            uint64_t& word{ plane[w][y] };
+
+            set_to_unset |= (word & bits) != 0;
+            word ^= bits;
+
+            if( hash_stale ) continue;
+            for( uint64_t toggled{bits}; toggled != 0; toggled &= toggled - 1 )
+            {
+                pixel_hash ^= pixelKey(p*PLANE_PIXELS + y*HIRES_WIDTH + 64*w + (63 - __builtin_ctzll(toggled)));
+            }
+        }
+    }
+    return set_to_unset;
+};
+
+void Framebuffer::clearScreen(uint8_t plane_mask)
+{
+    if( (plane_mask & ALL_PLANES) == ALL_PLANES )
+    {
+        for( auto& plane : planes )
+        {
+            for( auto& column : plane ) column.fill(0);
+        }
+        pixel_hash = hires ? HIRES_KEY : 0;
+        hash_stale = !hashing;
+        return;
+    }
+
+    // A partial clear, as 00E0 with one plane selected, takes the keys of the
+    // pixels it turns off out of the hash, so hash() stays O(1).
+    for( std::size_t p{0}; p < PLANES; ++p )
+    {
+        if( (plane_mask & (1 << p)) == 0 ) continue;
+
+        for( std::size_t w{0}; w < ROW_WORDS; ++w )
+        {
+            for( std::size_t y{0}; y < HIRES_HEIGHT; ++y )
+            {
+                uint64_t& word{ planes[p][w][y] };
+                for( uint64_t lit{ hash_stale ? 0 : word }; lit != 0; lit &= lit - 1 )
+                {
+                    pixel_hash ^= pixelKey(p*PLANE_PIXELS + y*HIRES_WIDTH + 64*w + (63 - __builtin_ctzll(lit)));
+                }
+                word = 0;
+            }
+        }
+    }
+};
+
+void Framebuffer::assign(const Framebuffer& source)
+{
+    if( !hash_stale && hires != source.hires ) pixel_hash ^= HIRES_KEY;
+    hires = source.hires;
+
+    for( std::size_t p{0}; p < PLANES; ++p )
+    {
+        for( std::size_t w{0}; w < ROW_WORDS; ++w )
+        {
+            for( std::size_t y{0}; y < HIRES_HEIGHT; ++y )
+            {
+                uint64_t& word{ planes[p][w][y] };
+                const uint64_t changed{ word ^ source.planes[p][w][y] };
+                if( changed == 0 ) continue;
+
+                word ^= changed;
+                if( hash_stale ) continue;
+                for( uint64_t toggled{changed}; toggled != 0; toggled &= toggled - 1 )
+                {
+                    pixel_hash ^= pixelKey(p*PLANE_PIXELS + y*HIRES_WIDTH + 64*w + (63 - __builtin_ctzll(toggled)));
+                }
+            }
+        }
+    }
+};
+
+void Framebuffer::scroll(int dx, int dy, uint8_t plane_mask)
+{
+    const std::size_t row_count{ height() };
+    const std::size_t words{ hires ? ROW_WORDS : 1u };
+
+    for( std::size_t p{0}; p < PLANES; ++p )
+    {
+        if( (plane_mask & (1 << p)) == 0 ) continue;
+
+        Plane& plane{ planes[p] };
+        for( std::size_t w{0}; w < words; ++w )
+        {
+            auto first{ plane[w].begin() };
+            const std::size_t n{ std::min<std::size_t>(static_cast<std::size_t>(std::abs(dy)), row_count) };
+
+            if( dy > 0 )
+            {
+                std::copy_backward(first, first + (row_count - n), first + row_count);
+                std::fill(first, first + n, 0);
+            }
+            else if( dy < 0 )
+            {
+                std::copy(first + n, first + row_count, first);
+                std::fill(first + (row_count - n), first + row_count, 0);
+            }
+        }
+
+        // Each pass shifts whole columns of words, carrying bits between the
+        // two halves of a hires row.
+        for( int remaining{ std::abs(dx) }; remaining > 0; remaining -= 63 )
+        {
+            const int n{ std::min(remaining, 63) };
+
+            if( dx > 0 )
+            {
+                for( std::size_t w{words - 1}; w > 0; --w )
+                {
+                    for( std::size_t y{0}; y < row_count; ++y )
+                    {
+                        plane[w][y] = (plane[w][y] >> n) | (plane[w - 1][y] << (64 - n));
+                    }
+                }
+                for( std::size_t y{0}; y < row_count; ++y ) plane[0][y] >>= n;
+            }
+            else
+            {
+                for( std::size_t w{0}; w + 1 < words; ++w )
+                {
+                    for( std::size_t y{0}; y < row_count; ++y )
+                    {
+                        plane[w][y] = (plane[w][y] << n) | (plane[w + 1][y] >> (64 - n));
+                    }
+                }
+                for( std::size_t y{0}; y < row_count; ++y ) plane[words - 1][y] <<= n;
+            }
+        }
+    }
+    hash_stale = true;
+};
+
+void Framebuffer::rehash() const
+{
+    hash_stale = !hashing;
+    pixel_hash = hires ? HIRES_KEY : 0;
+
+    for( std::size_t p{0}; p < PLANES; ++p )
+    {
+        for( std::size_t w{0}; w < ROW_WORDS; ++w )
+        {
+            for( std::size_t y{0}; y < HIRES_HEIGHT; ++y )
+            {
+                for( uint64_t lit{ planes[p][w][y] }; lit != 0; lit &= lit - 1 )
+                {
+                    pixel_hash ^= pixelKey(p*PLANE_PIXELS + y*HIRES_WIDTH + 64*w + (63 - __builtin_ctzll(lit)));
+                }
+            }
+        }
+    }
+};
+
+void Framebuffer::setHires(bool hires)
+{
+    this->hires = hires;
+    clearScreen();
+};
+
+bool Framebuffer::isHires() const
+{
+    return hires;
+};
+
+std::size_t Framebuffer::width() const
+{
+    return hires ? HIRES_WIDTH : WIDTH;
+};
+
+std::size_t Framebuffer::height() const
+{
+    return hires ? HIRES_HEIGHT : HEIGHT;
+};
+
+uint8_t Framebuffer::pixel(std::size_t x, std::size_t y) const
+{
+    x %= width();
+    y %= height();
+
+    uint8_t colour{0};
+    for( std::size_t p{0}; p < PLANES; ++p )
+    {
+        colour |= ((planes[p][x / 64][y] >> (63 - x % 64)) & 1) << p;
+    }
+    return colour;
+};
+
+const Framebuffer::Plane& Framebuffer::getPlane(std::size_t plane) const
+{
+    return planes[plane];
+};
+
+void Framebuffer::setPlane(std::size_t plane, const Plane& pixels)
+{
+    planes[plane] = pixels;
+    hash_stale = true;
+};
+
+uint64_t Framebuffer::hash() const
+{
+    if( hash_stale ) rehash();
+    return pixel_hash;
+};
+
+void Framebuffer::setHashing(bool enabled)
+{
+    hashing = enabled;
+    hash_stale = hash_stale || !enabled;
+};
+
+void Framebuffer::render(uint32_t out[], const std::array<uint32_t, COLOURS>& palette) const
+{
+    const std::size_t row_width{ width() };
+    const std::size_t row_count{ height() };
+
+    for( std::size_t y{0}; y < row_count; ++y )
+    {
+        for( std::size_t x{0}; x < row_width; ++x )
+        {
+            const std::size_t bit{ 63 - x % 64 };
+
+            std::size_t colour{0};
+            for( std::size_t p{0}; p < PLANES; ++p ) colour |= ((planes[p][x / 64][y] >> bit) & 1) << p;
+
+            out[y*row_width + x] = palette[colour];
+        }
+    }
+};
+
+void Framebuffer::render(uint32_t out[], uint32_t off_pixel, uint32_t on_pixel) const
+{
+    std::array<uint32_t, COLOURS> palette{};
+    palette.fill(on_pixel);
+    palette[0] = off_pixel;
+
+    render(out, palette);
+};
+
+void Framebuffer::render(uint8_t out[]) const
+{
+    const std::size_t row_width{ width() };
+    const std::size_t row_count{ height() };
+
+    for( std::size_t y{0}; y < row_count; ++y )
+    {
+        for( std::size_t x{0}; x < row_width; ++x )
+        {
+            out[y*row_width + x] = pixel(x, y);
+        }
+    }
+};
+
+void Framebuffer::renderLores(uint8_t out[]) const
+{
+    if( !hires )
+    {
+        render(out);
+        return;
+    }
+
+    for( std::size_t y{0}; y < HEIGHT; ++y )
+    {
+        for( std::size_t x{0}; x < WIDTH; ++x )
+        {
+            out[y*WIDTH + x] = pixel(2*x, 2*y) | pixel(2*x + 1, 2*y) | pixel(2*x, 2*y + 1) | pixel(2*x + 1, 2*y + 1);
+        }
+    }
+};
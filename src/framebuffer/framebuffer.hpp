@@ -0,0 +1,108 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Declares the pure C++ framebuffer of the Chip8 display. Pixels are bit
+    packed, and presenters (SDL, capture, streaming) convert them to their own
+    format when a frame is shown.
+
+    Storage is always sized for the SUPER-CHIP/XO-CHIP 128x64 mode with one
+    bitplane per XO-CHIP plane, so switching resolution only flips a flag. A
+    plane holds each 128 pixel row as two 64-bit words, and the words of all
+    rows are stored contiguously per column. Scrolls and plane masked draws are
+    plain loops over those word arrays that the compiler turns into SIMD.
+*/
+
+#ifndef FRAMEBUFFER_H
+#define FRAMEBUFFER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "header.hpp"
+
+#define ROW_WORDS (HIRES_WIDTH / 64)
+#define COLOURS (1 << PLANES)
+#define ALL_PLANES (COLOURS - 1)
+
+static_assert(WIDTH == 64, "Framebuffer packs one lores row into a 64-bit word");
+static_assert(HIRES_WIDTH == 2*WIDTH && HIRES_HEIGHT == 2*HEIGHT, "Hires mode doubles the lores resolution");
+
+class Framebuffer
+{
+    public:
+        // words[w][y] holds pixels x = 64w to 64w + 63 of row y, the most
+        // significant bit being the leftmost. Lores mode uses words[0] of
+        // rows 0 to HEIGHT - 1.
+        using Plane = std::array<std::array<uint64_t, HIRES_HEIGHT>, ROW_WORDS>;
+
+    private:
+        std::array<Plane, PLANES> planes{};
+        bool hires{false};
+
+        // XOR of pixelKey() over every lit pixel and the mode, see hash.hpp.
+        // Draws keep it up to date; scrolls move every pixel, so they only
+        // mark it stale and hash() recomputes it when next asked.
+        mutable uint64_t pixel_hash{};
+        mutable bool hash_stale{false};
+
+        // Off for copies that are drawn on but never hashed, see setHashing().
+        bool hashing{true};
+
+        template<bool Wrap>
+        bool drawRows(Plane& plane, std::size_t p, uint16_t x_pos, uint16_t y_pos,
+            const uint8_t data[], std::size_t rows, bool wide);
+
+        void rehash() const;
+
+    public:
+        // Sprites are rows of 8 pixels, or 16 when wide. Each plane selected
+        // by the mask consumes its own rows from data, lowest plane first.
+        // Sprites wrap their starting position and, unless wrap is set, clip
+        // at the right and bottom edges. Returns true if any lit pixel was
+        // turned off.
+        bool drawPixelData(uint16_t x_pos, uint16_t y_pos, const uint8_t data[], std::size_t rows,
+            bool wrap = false, bool wide = false, uint8_t plane_mask = 1);
+
+        void clearScreen(uint8_t plane_mask = ALL_PLANES);
+
+        // Takes the mode and pixels of source in one pass over the words,
+        // updating the hash only for the pixels that differ.
+        void assign(const Framebuffer& source);
+
+        // Moves the selected planes by dx, dy pixels of the current mode;
+        // pixels scrolled in are unlit.
+        void scroll(int dx, int dy, uint8_t plane_mask = ALL_PLANES);
+
+        // Switching mode clears every plane.
+        void setHires(bool hires);
+        bool isHires() const;
+
+        std::size_t width() const;
+        std::size_t height() const;
+
+        // Returns the colour index of the pixel, one bit per plane.
+        uint8_t pixel(std::size_t x, std::size_t y) const;
+        const Plane& getPlane(std::size_t plane) const;
+
+        // Replaces a plane's words, as saved from getPlane(), in either mode.
+        void setPlane(std::size_t plane, const Plane& pixels);
+
+        uint64_t hash() const;
+
+        // With hashing off, draws skip the per pixel hash update and hash()
+        // recomputes it from scratch.
+        void setHashing(bool enabled);
+
+        // Write width()*height() values, row major.
+        void render(uint32_t out[], const std::array<uint32_t, COLOURS>& palette) const;
+        void render(uint32_t out[], uint32_t off_pixel, uint32_t on_pixel) const;
+        void render(uint8_t out[]) const;
+
+        // Writes WIDTH*HEIGHT values whatever the mode; a lores pixel is lit if
+        // any pixel of its 2x2 hires block is.
+        void renderLores(uint8_t out[]) const;
+};
+
+#endif
@@ -0,0 +1,448 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Defines the differential fuzzer, its program generator and minimizer.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iterator>
+#include <mutex>
+
+#include "fuzz.hpp"
+#include "debugger.hpp"
+#include "workers.hpp"
+
+#define CORPUS_SIZE 256
+#define MAX_PROGRAM 512
+
+void stepReference(Chip8& cpu)
+{
+    cpu.execute(cpu.fetch());
+}
+
+void stepCycle(Chip8& cpu)
+{
+    cpu.cycle(1);
+}
+
+void stepDebugger(Chip8& cpu)
+{
+    thread_local Debugger debugger{};
+    debugger.run(cpu, 1);
+}
+
+bool backendFromName(const std::string& name, Backend& backend)
+{
+    if( name == "reference" )       backend = stepReference;
+    else if( name == "cycle" )      backend = stepCycle;
+    else if( name == "debugger" )   backend = stepDebugger;
+    else return false;
+
+    return true;
+}
+
+FuzzBus::FuzzBus(const FuzzCase& test) :
+    cpu(*this),
+    random(test.seed),
+    key( static_cast<uint8_t>(test.seed & 0x1F) )
+{
+    cpu.setProfile(test.profile);
+    cpu.loadData(MEM_ADDR_START, test.program.data(), static_cast<int>(test.program.size()));
+};
+
+void FuzzBus::notify(EventData event)
+{
+    switch(event.type)
+    {
+        case EventType::DISPLAY_CLEAR:
+            framebuffer.clearScreen(event.planes);
+            break;
+        case EventType::DISPLAY_DRAW:
+            cpu.setStatusReg(
+                framebuffer.drawPixelData(
+                    event.draw.xpos,
+                    event.draw.ypos,
+                    event.draw.data,
+                    event.draw.size,
+                    event.draw.wrap,
+                    event.draw.wide,
+                    event.draw.planes
+                )
+            );
+            break;
+        case EventType::DISPLAY_SCROLL:
+            framebuffer.scroll(event.scroll.dx, event.scroll.dy, event.scroll.planes);
+            break;
+        case EventType::DISPLAY_MODE:
+            framebuffer.setHires(event.hires);
+            break;
+        case EventType::KEYBOARD_GET:
+            *event.key = (key > 0xF) ? KEY_NOTPRESSED : key;
+            break;
+        case EventType::RANDOM:
+            *event.random.dest = event.random.mask & random.next();
+            break;
+    }
+};
+
+std::size_t coverageIndex(uint16_t opcode)
+{
+    const std::size_t family{ static_cast<std::size_t>(opcode >> 12) };
+
+    switch(family)
+    {
+        case 0x0:
+            return (family << 4) | ((opcode >> 4) & 0xF);
+        case 0x8:
+            return (family << 4) | (opcode & 0xF);
+        case 0xE:
+        case 0xF:
+            return (family << 4) | ((opcode ^ (opcode >> 4)) & 0xF);
+        default:
+            return family << 4;
+    }
+}
+
+std::string compare(const FuzzBus& reference, const FuzzBus& candidate)
+{
+    const Chip8State& a{ reference.cpu.getState() };
+    const Chip8State& b{ candidate.cpu.getState() };
+
+    if( a.pc != b.pc ) return "pc";
+    if( a.index_reg != b.index_reg ) return "index_reg";
+    if( a.sp != b.sp ) return "sp";
+    if( a.delay != b.delay ) return "delay";
+    if( a.sound != b.sound ) return "sound";
+    if( a.planes != b.planes ) return "planes";
+
+    for( std::size_t i{0}; i < 16; ++i )
+    {
+        if( a.reg[i] != b.reg[i] ) return "reg[" + std::to_string(i) + "]";
+        if( a.stack[i] != b.stack[i] ) return "stack[" + std::to_string(i) + "]";
+        if( a.flags[i] != b.flags[i] ) return "flags[" + std::to_string(i) + "]";
+    }
+
+    if( a.memory != b.memory )
+    {
+        const auto diff{ std::mismatch(a.memory.begin(), a.memory.end(), b.memory.begin()) };
+        return "memory[" + std::to_string(diff.first - a.memory.begin()) + "]";
+    }
+    if( a.memory_hash != b.memory_hash ) return "memory_hash";
+
+    // Accesses past 0xFFF wrap through the guard, which must mirror the start.
+    for( const Chip8State* state : { &a, &b } )
+    {
+        if( !std::equal(state->memory.begin(), state->memory.begin() + MEM_GUARD, state->memory.begin() + MEM_SIZE) )
+        {
+            return (state == &a) ? "reference memory guard" : "memory guard";
+        }
+    }
+
+    const Framebuffer& fa{ reference.framebuffer };
+    const Framebuffer& fb{ candidate.framebuffer };
+
+    if( fa.isHires() != fb.isHires() ) return "hires";
+    for( std::size_t p{0}; p < PLANES; ++p )
+    {
+        if( fa.getPlane(p) != fb.getPlane(p) ) return "framebuffer plane " + std::to_string(p);
+    }
+    if( fa.hash() != fb.hash() ) return "framebuffer hash";
+
+    return "";
+}
+
+Divergence runLockstep(const FuzzCase& test, Backend candidate, Coverage* coverage)
+{
+    FuzzBus reference{test};
+    FuzzBus other{test};
+
+    Divergence result{};
+    for( std::size_t step{0}; step < test.steps; ++step )
+    {
+        const uint16_t opcode{ reference.cpu.fetch() };
+        if( coverage ) coverage->set(coverageIndex(opcode));
+
+        stepReference(reference.cpu);
+        candidate(other.cpu);
+        result.executed = step + 1;
+
+        if( (step + 1) % INSTR_PER_FRAME == 0 )
+        {
+            reference.cpu.tickTimer();
+            other.cpu.tickTimer();
+        }
+
+        const std::string field{ compare(reference, other) };
+        if( !field.empty() )
+        {
+            result.found = true;
+            result.step = step;
+            result.field = field;
+            return result;
+        }
+    }
+    return result;
+}
+
+FuzzCase minimize(FuzzCase test, Backend candidate)
+{
+    // Attempts run for the original budget: removing a jump can make the
+    // divergence take longer to reach.
+    const std::size_t budget{ test.steps };
+    auto diverges = [candidate, budget](FuzzCase& attempt)
+    {
+        attempt.steps = budget;
+        return runLockstep(attempt, candidate).found;
+    };
+
+    if( !diverges(test) ) return test;
+
+    while( test.program.size() > 2 )
+    {
+        FuzzCase attempt{test};
+        attempt.program.resize((attempt.program.size() / 2) & ~std::size_t{1});
+        if( attempt.program.empty() || !diverges(attempt) ) break;
+        test = attempt;
+    }
+
+    while( test.program.size() > 2 )
+    {
+        FuzzCase attempt{test};
+        attempt.program.resize(attempt.program.size() - 2);
+        if( !diverges(attempt) ) break;
+        test = attempt;
+    }
+
+    // 0x0000 is a no-op in every profile. Removing one instruction can make
+    // an earlier one removable, so passes repeat until nothing changes.
+    for( bool changed{true}; changed; )
+    {
+        changed = false;
+        for( std::size_t i{0}; i + 1 < test.program.size(); i += 2 )
+        {
+            if( test.program[i] == 0 && test.program[i + 1] == 0 ) continue;
+
+            FuzzCase attempt{test};
+            attempt.program[i] = 0;
+            attempt.program[i + 1] = 0;
+            if( !diverges(attempt) ) continue;
+
+            test = attempt;
+            changed = true;
+        }
+    }
+
+    while( test.program.size() > 2 && test.program[test.program.size() - 1] == 0 && test.program[test.program.size() - 2] == 0 )
+    {
+        test.program.resize(test.program.size() - 2);
+    }
+
+    test.steps = runLockstep(test, candidate).step + 1;
+    return test;
+}
+
+ProgramGenerator::ProgramGenerator(uint64_t seed, const std::vector<Profile>& profiles, std::size_t steps) :
+    random(seed),
+    profiles(profiles),
+    steps(steps)
+{
+    if( this->profiles.empty() )
+    {
+        this->profiles = { Profile::DEFAULT, Profile::COSMAC_VIP, Profile::CHIP_48, Profile::SUPER_CHIP, Profile::XO_CHIP };
+    }
+};
+
+// Valid opcodes with operands biased towards useful values: jumps and calls
+// land inside the program and index_reg points at scratch memory after it.
+uint16_t ProgramGenerator::randomOpcode(std::size_t length)
+{
+    static const uint16_t SYSTEM[]{ 0x00E0, 0x00EE, 0x00C3, 0x00D2, 0x00FB, 0x00FC, 0x00FE, 0x00FF };
+    static const uint8_t ARITHMETIC[]{ 0x0, 0x1, 0x2, 0x3, 0x4, 0x5, 0x6, 0x7, 0xE };
+    static const uint8_t MISC[]{ 0x07, 0x0A, 0x15, 0x18, 0x1E, 0x29, 0x30, 0x33, 0x55, 0x65, 0x75, 0x85, 0x01 };
+
+    const uint64_t bits{ random.next64() };
+    const uint16_t x{ static_cast<uint16_t>((bits >> 8) & 0xF) };
+    const uint16_t y{ static_cast<uint16_t>((bits >> 12) & 0xF) };
+    const uint16_t nn{ static_cast<uint16_t>((bits >> 16) & 0xFF) };
+    const uint16_t target{ static_cast<uint16_t>(MEM_ADDR_START + 2*((bits >> 24) % std::max<std::size_t>(length / 2, 1))) };
+    const uint16_t scratch{ static_cast<uint16_t>(0x300 + (bits >> 40) % 0xB00) };
+
+    const uint16_t family{ static_cast<uint16_t>(bits & 0xF) };
+    switch(family)
+    {
+        case 0x0:
+            return SYSTEM[(bits >> 4) % std::size(SYSTEM)];
+        case 0x1:
+        case 0x2:
+        case 0xB:
+            return static_cast<uint16_t>((family << 12) | target);
+        case 0x5:
+        case 0x9:
+            return static_cast<uint16_t>((family << 12) | (x << 8) | (y << 4));
+        case 0x8:
+            return static_cast<uint16_t>(0x8000 | (x << 8) | (y << 4) | ARITHMETIC[(bits >> 4) % std::size(ARITHMETIC)]);
+        case 0xA:
+            return static_cast<uint16_t>(0xA000 | scratch);
+        case 0xD:
+            return static_cast<uint16_t>(0xD000 | (x << 8) | (y << 4) | ((bits >> 4) & 0xF));
+        case 0xE:
+            return static_cast<uint16_t>(0xE000 | (x << 8) | (((bits >> 4) & 1) ? 0x9E : 0xA1));
+        case 0xF:
+            return static_cast<uint16_t>(0xF000 | (x << 8) | MISC[(bits >> 4) % std::size(MISC)]);
+        default:
+            return static_cast<uint16_t>((family << 12) | (x << 8) | nn);
+    }
+};
+
+std::vector<uint8_t> ProgramGenerator::generate()
+{
+    const std::size_t length{ 2*(8 + random.next64() % 120) };
+    std::vector<uint8_t> program(length);
+
+    // A quarter of the programs are raw bytes, the rest valid opcodes.
+    const bool raw{ (random.next() & 3) == 0 };
+    for( std::size_t i{0}; i < length; i += 2 )
+    {
+        const uint16_t opcode{ raw ? static_cast<uint16_t>(random.next64()) : randomOpcode(length) };
+        program[i] = static_cast<uint8_t>(opcode >> 8);
+        program[i + 1] = static_cast<uint8_t>(opcode);
+    }
+    return program;
+};
+
+std::vector<uint8_t> ProgramGenerator::mutate(const std::vector<uint8_t>& parent)
+{
+    std::vector<uint8_t> program{parent};
+    const std::size_t edits{ 1u + random.next() % 4u };
+
+    for( std::size_t edit{0}; edit < edits; ++edit )
+    {
+        const std::size_t instructions{ program.size() / 2 };
+        const std::size_t at{ 2*(random.next64() % instructions) };
+        const std::size_t other{ 2*(random.next64() % instructions) };
+
+        switch(random.next() % 4)
+        {
+            case 0:
+            {
+                const uint16_t opcode{ randomOpcode(program.size()) };
+                program[at] = static_cast<uint8_t>(opcode >> 8);
+                program[at + 1] = static_cast<uint8_t>(opcode);
+                break;
+            }
+            case 1:
+                program[at + (random.next() & 1)] ^= static_cast<uint8_t>(1 << (random.next() % 8));
+                break;
+            case 2:
+                std::swap(program[at], program[other]);
+                std::swap(program[at + 1], program[other + 1]);
+                break;
+            case 3:
+            {
+                const std::size_t run{ std::min<std::size_t>(2*(1 + random.next() % 8), program.size() - at) };
+                if( program.size() + run > MAX_PROGRAM ) break;
+
+                const std::vector<uint8_t> copy(program.begin() + at, program.begin() + at + run);
+                program.insert(program.begin() + other, copy.begin(), copy.end());
+                break;
+            }
+        }
+    }
+    return program;
+};
+
+FuzzCase ProgramGenerator::next()
+{
+    FuzzCase test{};
+    test.program = (!corpus.empty() && (random.next() & 1)) ? mutate(corpus[random.next64() % corpus.size()]) : generate();
+    test.seed = random.next64();
+    test.profile = profiles[random.next64() % profiles.size()];
+    test.steps = steps;
+    return test;
+};
+
+void ProgramGenerator::record(const FuzzCase& test, const Coverage& coverage)
+{
+    if( (coverage & ~seen).none() ) return;
+
+    seen |= coverage;
+    if( corpus.size() < CORPUS_SIZE ) corpus.push_back(test.program);
+    else corpus[random.next64() % CORPUS_SIZE] = test.program;
+};
+
+struct FuzzContext
+{
+    const FuzzOptions& options;
+    std::chrono::steady_clock::time_point deadline;
+
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> cases{0};
+    std::atomic<uint64_t> instructions{0};
+
+    std::mutex mutex{};
+    FuzzResult result{};
+};
+
+void fuzzWorker(void *context, std::size_t begin, std::size_t end)
+{
+    FuzzContext& ctx{ *static_cast<FuzzContext *>(context) };
+    const FuzzOptions& options{ ctx.options };
+
+    for( std::size_t worker{begin}; worker < end; ++worker )
+    {
+        ProgramGenerator generator{ options.seed * 0x9E3779B97F4A7C15ULL + worker, options.profiles, options.steps };
+
+        while( !ctx.stop.load(std::memory_order_relaxed) )
+        {
+            if( options.max_cases > 0 )
+            {
+                if( ctx.cases.fetch_add(1, std::memory_order_relaxed) >= options.max_cases ) break;
+            }
+            else
+            {
+                if( std::chrono::steady_clock::now() >= ctx.deadline ) break;
+                ctx.cases.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            const FuzzCase test{ generator.next() };
+
+            Coverage coverage{};
+            const Divergence divergence{ runLockstep(test, options.candidate, &coverage) };
+            ctx.instructions.fetch_add(divergence.executed, std::memory_order_relaxed);
+
+            if( !divergence.found )
+            {
+                generator.record(test, coverage);
+                continue;
+            }
+
+            ctx.stop.store(true, std::memory_order_relaxed);
+
+            std::lock_guard<std::mutex> lock{ctx.mutex};
+            if( ctx.result.divergence.found ) break;
+
+            ctx.result.reproducer = minimize(test, options.candidate);
+            ctx.result.divergence = runLockstep(ctx.result.reproducer, options.candidate);
+            break;
+        }
+    }
+}
+
+FuzzResult fuzz(const FuzzOptions& options)
+{
+    FuzzContext ctx{
+        options,
+        std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(options.seconds))
+    };
+
+    WorkerPool pool{options.threads};
+    pool.dispatch(fuzzWorker, &ctx, pool.size());
+
+    ctx.result.cases = std::min<uint64_t>(ctx.cases.load(), options.max_cases > 0 ? options.max_cases : ctx.cases.load());
+    ctx.result.instructions = ctx.instructions.load();
+    return ctx.result;
+}
@@ -0,0 +1,123 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Declares the differential fuzzer. Random and mutated programs run on the
+    reference interpreter (Chip8::execute on each fetched opcode) and on a
+    candidate backend in lockstep, each on its own bus with the same seed, and
+    the full state and framebuffer are compared after every instruction. A
+    divergence is shrunk to a small reproducer before it is reported.
+*/
+
+#ifndef FUZZ_H
+#define FUZZ_H
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "bus.hpp"
+#include "chip8.hpp"
+#include "framebuffer.hpp"
+#include "random.hpp"
+
+// Advances the cpu by exactly one instruction.
+using Backend = void (*)(Chip8& cpu);
+
+void stepReference(Chip8& cpu);
+void stepCycle(Chip8& cpu);
+void stepDebugger(Chip8& cpu);
+
+// Accepts "reference", "cycle" and "debugger".
+bool backendFromName(const std::string& name, Backend& backend);
+
+struct FuzzCase
+{
+    std::vector<uint8_t> program{};
+    uint64_t seed{};
+    Profile profile{};
+    std::size_t steps{};
+};
+
+struct Divergence
+{
+    bool found{};
+    std::size_t step{};
+    std::string field{};
+
+    // Instructions compared before the case diverged or ended.
+    std::size_t executed{};
+};
+
+// The MockBus of test.cpp with a real framebuffer, a seeded random source and
+// one key held for the whole run (none if the seed picks a value above 0xF).
+class FuzzBus : public Bus
+{
+    public:
+        Chip8 cpu;
+        Framebuffer framebuffer{};
+        Random random;
+        uint8_t key{};
+
+        FuzzBus(const FuzzCase& test);
+
+        void notify(EventData event);
+};
+
+// One bit per opcode family and sub-operation the reference executed.
+using Coverage = std::bitset<256>;
+
+Divergence runLockstep(const FuzzCase& test, Backend candidate, Coverage* coverage = nullptr);
+
+// Shrinks the program and step count while the case still diverges.
+FuzzCase minimize(FuzzCase test, Backend candidate);
+
+class ProgramGenerator
+{
+    private:
+        Random random;
+        std::vector<Profile> profiles{};
+        std::size_t steps{};
+
+        std::vector<std::vector<uint8_t>> corpus{};
+        Coverage seen{};
+
+        uint16_t randomOpcode(std::size_t length);
+        std::vector<uint8_t> generate();
+        std::vector<uint8_t> mutate(const std::vector<uint8_t>& program);
+
+    public:
+        ProgramGenerator(uint64_t seed, const std::vector<Profile>& profiles, std::size_t steps);
+
+        FuzzCase next();
+
+        // Keeps the program as a mutation parent if it reached new coverage.
+        void record(const FuzzCase& test, const Coverage& coverage);
+};
+
+struct FuzzOptions
+{
+    Backend candidate{stepCycle};
+    std::vector<Profile> profiles{};
+    double seconds{10};
+    uint64_t max_cases{};
+    std::size_t threads{};
+    uint64_t seed{};
+    std::size_t steps{2000};
+};
+
+struct FuzzResult
+{
+    uint64_t cases{};
+    uint64_t instructions{};
+    Divergence divergence{};
+    FuzzCase reproducer{};
+};
+
+// Runs one generator per worker thread until the time budget, or max_cases
+// when it is set, runs out or a divergence is found.
+FuzzResult fuzz(const FuzzOptions& options);
+
+#endif
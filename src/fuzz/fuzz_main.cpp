@@ -0,0 +1,117 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Entry point of the differential fuzzer. Fuzzes a backend against the
+    reference interpreter on every core and writes a minimized reproducer when
+    they diverge; --replay runs a reproducer again.
+
+    Usage: chip8_fuzz [--backend cycle|debugger] [--seconds N | --cases N] [--threads N]
+                      [--seed N] [--profile name] [--steps N] [--out file.ch8]
+           chip8_fuzz --replay file.ch8 --seed N --profile name --steps N [--backend name]
+*/
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "fuzz.hpp"
+
+void printDivergence(const FuzzCase& test, const Divergence& divergence)
+{
+    std::cout << "diverged at step " << divergence.step << " on " << divergence.field << std::endl;
+    std::cout << "program";
+    for( uint8_t byte : test.program ) std::cout << " " << std::hex << +byte << std::dec;
+    std::cout << std::endl;
+}
+
+int main( int argc, char* argv[] )
+{
+    FuzzOptions options{};
+    std::string backend_name{"cycle"};
+    std::string out{"divergence.ch8"};
+    const char* replay{nullptr};
+    Profile profile{};
+    bool profile_set{false};
+
+    for( int i{1}; i < argc; ++i )
+    {
+        const bool has_value{ i + 1 < argc };
+
+        if( std::strcmp(argv[i], "--backend") == 0 && has_value )
+        {
+            backend_name = argv[++i];
+            if( !backendFromName(backend_name, options.candidate) )
+            {
+                std::cerr << "Unknown backend " << backend_name << std::endl;
+                return 2;
+            }
+        }
+        else if( std::strcmp(argv[i], "--seconds") == 0 && has_value ) options.seconds = std::strtod(argv[++i], nullptr);
+        else if( std::strcmp(argv[i], "--cases") == 0 && has_value ) options.max_cases = std::strtoull(argv[++i], nullptr, 10);
+        else if( std::strcmp(argv[i], "--threads") == 0 && has_value ) options.threads = std::strtoul(argv[++i], nullptr, 10);
+        else if( std::strcmp(argv[i], "--seed") == 0 && has_value ) options.seed = std::strtoull(argv[++i], nullptr, 10);
+        else if( std::strcmp(argv[i], "--steps") == 0 && has_value ) options.steps = std::strtoul(argv[++i], nullptr, 10);
+        else if( std::strcmp(argv[i], "--out") == 0 && has_value ) out = argv[++i];
+        else if( std::strcmp(argv[i], "--replay") == 0 && has_value ) replay = argv[++i];
+        else if( std::strcmp(argv[i], "--profile") == 0 && has_value )
+        {
+            if( !profileFromName(argv[++i], profile) )
+            {
+                std::cerr << "Unknown profile " << argv[i] << std::endl;
+                return 2;
+            }
+            profile_set = true;
+            options.profiles = { profile };
+        }
+        else
+        {
+            std::cerr << "Unknown argument " << argv[i] << std::endl;
+            return 2;
+        }
+    }
+
+    if( replay != nullptr )
+    {
+        std::ifstream is{replay, std::ios_base::in | std::ios_base::binary};
+        if( !is.good() )
+        {
+            std::cerr << "Could not read " << replay << std::endl;
+            return 2;
+        }
+
+        const FuzzCase test{
+            { std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>() },
+            options.seed,
+            profile_set ? profile : Profile::DEFAULT,
+            options.steps
+        };
+        const Divergence divergence{ runLockstep(test, options.candidate) };
+        if( !divergence.found )
+        {
+            std::cout << "no divergence in " << divergence.executed << " steps" << std::endl;
+            return 0;
+        }
+        printDivergence(test, divergence);
+        return 1;
+    }
+
+    const FuzzResult result{ fuzz(options) };
+    std::cout << "cases " << result.cases << " instructions " << result.instructions << std::endl;
+
+    if( !result.divergence.found ) return 0;
+
+    const FuzzCase& test{ result.reproducer };
+    printDivergence(test, result.divergence);
+
+    std::ofstream os{out, std::ios_base::out | std::ios_base::binary};
+    os.write(reinterpret_cast<const char *>(test.program.data()), static_cast<std::streamsize>(test.program.size()));
+
+    std::cout << "replay with: chip8_fuzz --replay " << out << " --seed " << test.seed << " --profile "
+              << profileName(test.profile) << " --steps " << test.steps << " --backend " << backend_name << std::endl;
+    return 1;
+}
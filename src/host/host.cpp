@@ -0,0 +1,281 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Defines the session host and its earliest deadline first workers.
+*/
+
+#include <algorithm>
+
+#include "host.hpp"
+
+static const HostClock::duration FRAME{ std::chrono::nanoseconds(HOST_FRAME_NS) };
+
+static uint64_t toNs(HostClock::duration duration)
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+}
+
+void LatencyBuckets::record(uint64_t ns)
+{
+    const uint64_t us{ ns / 1000 };
+    const std::size_t bucket{ (us == 0) ? 0 : static_cast<std::size_t>(63 - __builtin_clzll(us)) };
+    ++counts[std::min<std::size_t>(bucket, HOST_LATENCY_BUCKETS - 1)];
+    max_ns = std::max(max_ns, ns);
+};
+
+void LatencyBuckets::merge(const LatencyBuckets& other)
+{
+    for( std::size_t b{0}; b < HOST_LATENCY_BUCKETS; ++b ) counts[b] += other.counts[b];
+    max_ns = std::max(max_ns, other.max_ns);
+};
+
+uint64_t LatencyBuckets::percentileUs(double p) const
+{
+    uint64_t total{0};
+    for( uint64_t count : counts ) total += count;
+    if( total == 0 ) return 0;
+
+    const uint64_t rank{ std::max<uint64_t>(static_cast<uint64_t>(p * total + 0.5), 1) };
+    uint64_t seen{0};
+    for( std::size_t b{0}; b < HOST_LATENCY_BUCKETS; ++b )
+    {
+        seen += counts[b];
+        if( seen >= rank ) return uint64_t{2} << b;
+    }
+    return uint64_t{2} << (HOST_LATENCY_BUCKETS - 1);
+};
+
+Session::Session(std::size_t id, const uint8_t rom[], std::size_t size, Profile profile, uint64_t seed) :
+    cpu(*this),
+    random(seed),
+    id(id)
+{
+    cpu.setProfile(profile);
+    cpu.loadData(MEM_ADDR_START, rom, static_cast<int>(size));
+};
+
+void Session::notify(EventData event)
+{
+    switch(event.type)
+    {
+        case EventType::DISPLAY_CLEAR:
+            framebuffer.clearScreen(event.planes);
+            break;
+        case EventType::DISPLAY_DRAW:
+            cpu.setStatusReg(
+                framebuffer.drawPixelData(
+                    event.draw.xpos,
+                    event.draw.ypos,
+                    event.draw.data,
+                    event.draw.size,
+                    event.draw.wrap,
+                    event.draw.wide,
+                    event.draw.planes
+                )
+            );
+            break;
+        case EventType::DISPLAY_SCROLL:
+            framebuffer.scroll(event.scroll.dx, event.scroll.dy, event.scroll.planes);
+            break;
+        case EventType::DISPLAY_MODE:
+            framebuffer.setHires(event.hires);
+            break;
+        case EventType::KEYBOARD_GET:
+        {
+            // The core reads one key at a time, so the lowest held key wins.
+            const uint16_t held{ keys.load(std::memory_order_relaxed) };
+            *event.key = (held == 0) ? KEY_NOTPRESSED : static_cast<uint8_t>(__builtin_ctz(held));
+            break;
+        }
+        case EventType::RANDOM:
+            *event.random.dest = event.random.mask & random.next();
+            break;
+    }
+};
+
+// FX0A leaves pc on itself until a key is held.
+bool Session::waitingForKey() const
+{
+    const Chip8State& state{ cpu.getState() };
+    if( state.pc + 1 >= MEM_SIZE ) return false;
+
+    return (state.read(state.pc) & 0xF0) == 0xF0 && state.read(state.pc + 1) == 0x0A;
+};
+
+bool SessionHost::laterRelease(const Session* a, const Session* b)
+{
+    return a->release > b->release;
+};
+
+SessionHost::SessionHost(std::size_t threads, FrameSink sink, void *context) :
+    thread_count( (threads == 0) ? std::max(std::thread::hardware_concurrency(), 1u) : threads ),
+    sink(sink),
+    sink_context(context)
+{};
+
+SessionHost::~SessionHost()
+{
+    stop();
+};
+
+std::size_t SessionHost::addSession(const uint8_t rom[], std::size_t size, Profile profile, uint64_t seed)
+{
+    sessions.emplace_back(new Session(sessions.size(), rom, size, profile, seed));
+    return sessions.size() - 1;
+};
+
+void SessionHost::push(Session* session)
+{
+    queue.push_back(session);
+    std::push_heap(queue.begin(), queue.end(), laterRelease);
+};
+
+Session* SessionHost::pop()
+{
+    std::pop_heap(queue.begin(), queue.end(), laterRelease);
+    Session* session{ queue.back() };
+    queue.pop_back();
+    return session;
+};
+
+void SessionHost::setKeys(std::size_t session, uint16_t keys)
+{
+    Session& target{ *sessions[session] };
+    target.keys.store(keys, std::memory_order_relaxed);
+    if( keys == 0 ) return;
+
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        if( !target.parked ) return;
+
+        // Replays the timer ticks of the slots slept through, then rejoins
+        // the schedule on the current slot.
+        const HostClock::time_point now{ HostClock::now() };
+        const uint64_t missed{ (now > target.release) ? toNs(now - target.release) / HOST_FRAME_NS : 0 };
+        for( uint64_t i{0}; i < std::min<uint64_t>(missed, 0xFF); ++i ) target.cpu.tickTimer();
+
+        target.release += missed * FRAME;
+        target.stats.parked_frames += missed;
+        target.parked = false;
+        push(&target);
+    }
+    ready_cv.notify_one();
+};
+
+void SessionHost::start()
+{
+    std::lock_guard<std::mutex> lock{mutex};
+    if( !workers.empty() ) return;
+
+    started = HostClock::now();
+    stopping = false;
+    // Spreads the first slots over one frame so the sessions do not all
+    // fall due at the same instant.
+    for( std::size_t i{0}; i < sessions.size(); ++i )
+    {
+        sessions[i]->release = started + FRAME * i / sessions.size();
+        push(sessions[i].get());
+    }
+
+    for( std::size_t i{0}; i < thread_count; ++i ) workers.emplace_back(&SessionHost::workerLoop, this);
+};
+
+void SessionHost::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        if( workers.empty() ) return;
+        stopping = true;
+    }
+    ready_cv.notify_all();
+
+    for( std::thread& worker : workers ) worker.join();
+    workers.clear();
+
+    stopped = HostClock::now();
+    queue.clear();
+};
+
+void SessionHost::workerLoop()
+{
+    std::array<Session*, HOST_BATCH> batch{};
+
+    std::unique_lock<std::mutex> lock{mutex};
+    while( !stopping )
+    {
+        if( queue.empty() )
+        {
+            ready_cv.wait(lock);
+            continue;
+        }
+
+        const HostClock::time_point now{ HostClock::now() };
+        if( queue.front()->release > now )
+        {
+            ready_cv.wait_until(lock, queue.front()->release);
+            continue;
+        }
+
+        // Takes the earliest released frames together, one lock per batch.
+        std::size_t count{0};
+        while( count < HOST_BATCH && !queue.empty() && queue.front()->release <= now ) batch[count++] = pop();
+        lock.unlock();
+
+        for( std::size_t i{0}; i < count; ++i ) runFrame(*batch[i]);
+
+        lock.lock();
+        for( std::size_t i{0}; i < count; ++i )
+        {
+            Session* session{ batch[i] };
+            if( session->waitingForKey() && session->keys.load(std::memory_order_relaxed) == 0 ) session->parked = true;
+            else push(session);
+        }
+    }
+};
+
+void SessionHost::runFrame(Session& session)
+{
+    const HostClock::time_point start{ HostClock::now() };
+
+    session.cpu.cycle(INSTR_PER_FRAME);
+    session.cpu.tickTimer();
+
+    const HostClock::time_point end{ HostClock::now() };
+
+    SessionStats& stats{ session.stats };
+    ++stats.frames;
+    stats.cpu_ns += toNs(end - start);
+    stats.latency.record(toNs(end - session.release));
+    stats.misses += (end > session.release + FRAME);
+
+    if( sink ) sink(sink_context, session.id, session.framebuffer);
+
+    session.release += FRAME;
+};
+
+const SessionStats& SessionHost::sessionStats(std::size_t session) const
+{
+    return sessions[session]->stats;
+};
+
+HostStats SessionHost::stats() const
+{
+    HostStats host{ .sessions = sessions.size(), .threads = thread_count, .wall_ns = toNs(stopped - started) };
+
+    for( const std::unique_ptr<Session>& session : sessions )
+    {
+        const SessionStats& stats{ session->stats };
+        host.frames += stats.frames;
+        host.misses += stats.misses;
+        host.parked_frames += stats.parked_frames;
+        host.cpu_ns += stats.cpu_ns;
+        host.latency.merge(stats.latency);
+    }
+    return host;
+};
+
+std::size_t SessionHost::size() const
+{
+    return sessions.size();
+};
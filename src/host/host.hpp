@@ -0,0 +1,162 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Declares the session host, which runs many interactive Chip8 sessions in
+    one process. Each session is a CPU, framebuffer and random generator that
+    owes one frame every 1/60 s. A fixed set of worker threads takes frames
+    from a single queue ordered by deadline (earliest deadline first), and a
+    frame becomes runnable when its 1/60 s slot starts. A session blocked on
+    FX0A with no key held is parked: it leaves the queue until setKeys wakes
+    it, and the timer ticks it missed are replayed when it does.
+
+    Frame latency is the time from the start of a frame's slot to the end of
+    its slice. A frame that ends after its slot is a deadline miss.
+*/
+
+#ifndef HOST_H
+#define HOST_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "bus.hpp"
+#include "chip8.hpp"
+#include "framebuffer.hpp"
+#include "random.hpp"
+
+#define HOST_FRAME_NS 16666667
+#define HOST_LATENCY_BUCKETS 32
+
+// Released frames a worker takes off the queue per lock.
+#define HOST_BATCH 16
+
+using HostClock = std::chrono::steady_clock;
+
+// Frame latencies in power of two microsecond buckets, bucket b holding
+// [2^b, 2^(b+1)) us. Fixed size, so recording never allocates.
+struct LatencyBuckets
+{
+    std::array<uint64_t, HOST_LATENCY_BUCKETS> counts{};
+    uint64_t max_ns{};
+
+    void record(uint64_t ns);
+    void merge(const LatencyBuckets& other);
+
+    // Upper bound of the bucket holding the p quantile, p in [0, 1].
+    uint64_t percentileUs(double p) const;
+};
+
+struct SessionStats
+{
+    uint64_t frames{};
+    uint64_t misses{};
+    uint64_t parked_frames{};
+    uint64_t cpu_ns{};
+    LatencyBuckets latency{};
+};
+
+struct HostStats
+{
+    std::size_t sessions{};
+    std::size_t threads{};
+    uint64_t wall_ns{};
+
+    uint64_t frames{};
+    uint64_t misses{};
+    uint64_t parked_frames{};
+    uint64_t cpu_ns{};
+    LatencyBuckets latency{};
+};
+
+class Session : public Bus
+{
+    private:
+        friend class SessionHost;
+
+        Chip8 cpu;
+        Framebuffer framebuffer{};
+        Random random;
+        std::atomic<uint16_t> keys{0};
+
+        std::size_t id{};
+
+        // Start of the slot of the next frame, its deadline is one frame later.
+        HostClock::time_point release{};
+        bool parked{};
+
+        SessionStats stats{};
+
+        bool waitingForKey() const;
+
+    public:
+        Session(std::size_t id, const uint8_t rom[], std::size_t size, Profile profile, uint64_t seed);
+
+        void notify(EventData event);
+};
+
+class SessionHost
+{
+    public:
+        // Called on the worker that ran the frame, right after it.
+        using FrameSink = void (*)(void *context, std::size_t session, const Framebuffer& framebuffer);
+
+    private:
+        std::vector<std::unique_ptr<Session>> sessions{};
+        std::size_t thread_count{};
+
+        FrameSink sink{};
+        void *sink_context{};
+
+        // Min-heap on release, guarded by mutex.
+        std::vector<Session*> queue{};
+        std::mutex mutex{};
+        std::condition_variable ready_cv{};
+        bool stopping{};
+
+        std::vector<std::thread> workers{};
+        HostClock::time_point started{};
+        HostClock::time_point stopped{};
+
+        // Orders the heap so that the earliest release is at the front.
+        static bool laterRelease(const Session* a, const Session* b);
+
+        void push(Session* session);
+        Session* pop();
+
+        void workerLoop();
+        void runFrame(Session& session);
+
+    public:
+        // threads = 0 uses every hardware thread.
+        SessionHost(std::size_t threads = 0, FrameSink sink = nullptr, void *context = nullptr);
+        ~SessionHost();
+
+        SessionHost(const SessionHost&) = delete;
+        SessionHost& operator=(const SessionHost&) = delete;
+
+        // Sessions are added before start(). Returns the session id.
+        std::size_t addSession(const uint8_t rom[], std::size_t size, Profile profile, uint64_t seed);
+
+        // Bit n of keys holds key n. Safe to call from any thread while running.
+        void setKeys(std::size_t session, uint16_t keys);
+
+        void start();
+        void stop();
+
+        // Read after stop().
+        const SessionStats& sessionStats(std::size_t session) const;
+        HostStats stats() const;
+
+        std::size_t size() const;
+};
+
+#endif
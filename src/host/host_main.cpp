@@ -0,0 +1,106 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Entry point of the session host. Runs many copies of a ROM as separate
+    sessions for a while, pressing a random key on a few of them every tenth
+    of a second, and reports frame latency, deadline misses and how the CPU
+    time was shared.
+
+    Usage: chip8_host [--sessions N] [--threads N] [--seconds N] [--profile name] [--seed N] rom
+*/
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+#include "host.hpp"
+
+int main( int argc, char* argv[] )
+{
+    std::size_t session_count{256};
+    std::size_t threads{0};
+    double seconds{5};
+    Profile profile{Profile::DEFAULT};
+    uint64_t seed{1};
+    const char* rom_file{nullptr};
+
+    for( int i{1}; i < argc; ++i )
+    {
+        const bool has_value{ i + 1 < argc };
+
+        if( std::strcmp(argv[i], "--sessions") == 0 && has_value ) session_count = std::strtoul(argv[++i], nullptr, 10);
+        else if( std::strcmp(argv[i], "--threads") == 0 && has_value ) threads = std::strtoul(argv[++i], nullptr, 10);
+        else if( std::strcmp(argv[i], "--seconds") == 0 && has_value ) seconds = std::strtod(argv[++i], nullptr);
+        else if( std::strcmp(argv[i], "--seed") == 0 && has_value ) seed = std::strtoull(argv[++i], nullptr, 10);
+        else if( std::strcmp(argv[i], "--profile") == 0 && has_value )
+        {
+            if( !profileFromName(argv[++i], profile) )
+            {
+                std::cerr << "Unknown profile " << argv[i] << std::endl;
+                return 2;
+            }
+        }
+        else rom_file = argv[i];
+    }
+
+    std::ifstream is{rom_file ? rom_file : "", std::ios_base::in | std::ios_base::binary};
+    if( rom_file == nullptr || !is.good() )
+    {
+        std::cerr << "Usage: chip8_host [--sessions N] [--threads N] [--seconds N] [--profile name] [--seed N] rom" << std::endl;
+        return 2;
+    }
+    const std::vector<uint8_t> rom{ std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>() };
+
+    SessionHost host{threads};
+    for( std::size_t i{0}; i < session_count; ++i ) host.addSession(rom.data(), rom.size(), profile, seed + i);
+
+    host.start();
+
+    // Stands in for the players: a tenth of the sessions change keys each tick.
+    Random input{seed};
+    const HostClock::time_point end{ HostClock::now() + std::chrono::duration_cast<HostClock::duration>(std::chrono::duration<double>(seconds)) };
+    for( std::size_t tick{0}; HostClock::now() < end; ++tick )
+    {
+        for( std::size_t s{tick % 10}; s < session_count; s += 10 )
+        {
+            host.setKeys(s, (input.next() & 1) ? static_cast<uint16_t>(1u << (input.next() & 0xF)) : 0);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    host.stop();
+
+    const HostStats stats{ host.stats() };
+    const double wall_s{ stats.wall_ns / 1e9 };
+    const double slice_ns{ static_cast<double>(stats.cpu_ns) / std::max<uint64_t>(stats.frames, 1) };
+
+    std::cout << stats.sessions << " sessions on " << stats.threads << " threads for " << std::fixed << std::setprecision(2)
+              << wall_s << " s" << std::endl;
+    std::cout << "frames " << stats.frames << ", parked " << stats.parked_frames << ", missed " << stats.misses
+              << " (" << 100.0 * stats.misses / std::max<uint64_t>(stats.frames, 1) << "%)" << std::endl;
+    std::cout << "frame latency p50 <" << stats.latency.percentileUs(0.5) << " us, p99 <" << stats.latency.percentileUs(0.99)
+              << " us, p99.9 <" << stats.latency.percentileUs(0.999) << " us, max " << stats.latency.max_ns / 1000 << " us" << std::endl;
+    std::cout << "busy " << 100.0 * stats.cpu_ns / (stats.wall_ns * stats.threads) << "% of the workers, "
+              << std::setprecision(0) << slice_ns << " ns per frame, room for about "
+              << HOST_FRAME_NS / std::max(slice_ns, 1.0) << " sessions per core" << std::endl;
+
+    // Share of the CPU time the host spent, per session.
+    std::vector<double> shares{};
+    for( std::size_t s{0}; s < host.size(); ++s )
+    {
+        shares.push_back(100.0 * host.sessionStats(s).cpu_ns / std::max<uint64_t>(stats.cpu_ns, 1));
+    }
+    const auto [low, high]{ std::minmax_element(shares.begin(), shares.end()) };
+    if( !shares.empty() )
+    {
+        std::cout << std::setprecision(3) << "cpu share per session min " << *low << "% max " << *high
+                  << "% (even share " << 100.0 / shares.size() << "%)" << std::endl;
+    }
+    return stats.misses > 0 ? 1 : 0;
+}
@@ -15,6 +15,8 @@ enum class EventType
 {
     DISPLAY_CLEAR,
     DISPLAY_DRAW,
+    DISPLAY_SCROLL,
+    DISPLAY_MODE,
     KEYBOARD_GET,
     RANDOM
 };
@@ -28,9 +30,20 @@ struct EventData
         {
             uint8_t xpos;
             uint8_t ypos;
-            uint8_t *data;
+            const uint8_t *data;
             std::size_t size;
+            bool wrap;
+            bool wide;
+            uint8_t planes;
         } draw;
+        struct
+        {
+            int8_t dx;
+            int8_t dy;
+            uint8_t planes;
+        } scroll;
+        uint8_t planes;
+        bool hires;
         uint8_t *key;
         struct
         {
@@ -0,0 +1,45 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Declares and defines the keys of the incremental (Zobrist style) hashes.
+    A hash is the XOR of one key per memory byte or lit pixel, so each write
+    updates it with two XORs instead of rehashing the whole buffer.
+*/
+
+#ifndef HASH_H
+#define HASH_H
+
+#include <cstddef>
+#include <cstdint>
+
+// splitmix64 finalizer.
+inline uint64_t mixHash(uint64_t x)
+{
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// Zero bytes have no key, so cleared memory hashes to 0.
+inline uint64_t memoryKey(uint16_t addr, uint8_t value)
+{
+    return (value == 0) ? 0 : mixHash((static_cast<uint64_t>(addr) << 8) | value);
+}
+
+inline uint64_t pixelKey(std::size_t index)
+{
+    return mixHash(0x5049584Cull ^ (static_cast<uint64_t>(index) << 32));
+}
+
+inline uint64_t hashMemory(const uint8_t memory[], std::size_t size)
+{
+    uint64_t hash{0};
+    for( std::size_t addr{0}; addr < size; ++addr )
+    {
+        hash ^= memoryKey(static_cast<uint16_t>(addr), memory[addr]);
+    }
+    return hash;
+}
+
+#endif
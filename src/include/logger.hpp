@@ -54,6 +54,9 @@ class Logger
 
 #else
 
+#include <ostream>
+#include <string>
+
 class Logger
 {
     public:
@@ -0,0 +1,52 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Declares and defines a small seedable random byte generator (xorshift64*).
+    Cheap enough to give every emulated instance its own reproducible stream.
+*/
+
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cstdint>
+
+class Random
+{
+    private:
+        uint64_t current{};
+
+    public:
+        Random(uint64_t seed = 0) { this->seed(seed); };
+
+        // Seeds through splitmix64 so that nearby seeds give unrelated streams.
+        void seed(uint64_t seed)
+        {
+            uint64_t z{ seed + 0x9E3779B97F4A7C15ULL };
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            current = (z ^ (z >> 31)) | 1;
+        };
+
+        uint64_t next64()
+        {
+            current ^= current >> 12;
+            current ^= current << 25;
+            current ^= current >> 27;
+            return current * 0x2545F4914F6CDD1DULL;
+        };
+
+        uint8_t next() { return static_cast<uint8_t>(next64() >> 56); };
+
+        // The generator's position, and a generator resumed from one, for
+        // savestates.
+        uint64_t state() const { return current; };
+        static Random fromState(uint64_t state)
+        {
+            Random random{};
+            random.current = state;
+            return random;
+        };
+};
+
+#endif
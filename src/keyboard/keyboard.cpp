@@ -2,34 +2,32 @@
     Author: Min Kang
     Creation Date: January 29th, 2022
 
-    Defines the SDL keyboard input wrapper class
+    Defines the keyboard input wrapper class
     Passes events onto Chip8 through the bus.
 */
 
-#include <iostream>
-
 #include "header.hpp"
 #include "logger.hpp"
 #include "keyboard.hpp"
 
 // Index represents button #.
-const SDL_Scancode KEYBOARD_MAP[16] {
-    SDL_SCANCODE_X,
-    SDL_SCANCODE_1,
-    SDL_SCANCODE_2,
-    SDL_SCANCODE_3,
-    SDL_SCANCODE_Q,
-    SDL_SCANCODE_W,
-    SDL_SCANCODE_E,
-    SDL_SCANCODE_A,
-    SDL_SCANCODE_S,
-    SDL_SCANCODE_D,
-    SDL_SCANCODE_Z,
-    SDL_SCANCODE_C,
-    SDL_SCANCODE_4,
-    SDL_SCANCODE_R,
-    SDL_SCANCODE_F,
-    SDL_SCANCODE_V,
+const Scancode KEYBOARD_MAP[16] {
+    SCANCODE_X,
+    SCANCODE_1,
+    SCANCODE_2,
+    SCANCODE_3,
+    SCANCODE_Q,
+    SCANCODE_W,
+    SCANCODE_E,
+    SCANCODE_A,
+    SCANCODE_S,
+    SCANCODE_D,
+    SCANCODE_Z,
+    SCANCODE_C,
+    SCANCODE_4,
+    SCANCODE_R,
+    SCANCODE_F,
+    SCANCODE_V,
 };
 
 Keyboard::Keyboard(Bus& bus) :
@@ -41,7 +39,7 @@ uint8_t Keyboard::getKey() {
     return key;
 };
 
-void Keyboard::storeKey(SDL_Scancode scancode)
+void Keyboard::storeKey(uint16_t scancode)
 {
     for(uint8_t i{0}; i < 16; i++)
     {
@@ -2,21 +2,42 @@
     Author: Min Kang
     Creation Date: January 29th, 2022
 
-    Declares wrapper for SDL keyboard input event handling.
+    Declares wrapper for keyboard input event handling.
     Passes events onto Chip8 through the bus.
 */
 
 #ifndef KEYBOARD_H
 #define KEYBOARD_H
 
-#include <SDL_keyboard.h>
-
 #include <cstdint>
 
 #include "header.hpp"
 #include "logger.hpp"
 #include "bus.hpp"
 
+// USB HID keyboard usage IDs. SDL_Scancode uses the same values, so SDL
+// events can be passed straight to storeKey without linking SDL here.
+enum Scancode : uint16_t
+{
+    SCANCODE_UNKNOWN = 0,
+    SCANCODE_A = 4,
+    SCANCODE_C = 6,
+    SCANCODE_D = 7,
+    SCANCODE_E = 8,
+    SCANCODE_F = 9,
+    SCANCODE_Q = 20,
+    SCANCODE_R = 21,
+    SCANCODE_S = 22,
+    SCANCODE_V = 25,
+    SCANCODE_W = 26,
+    SCANCODE_X = 27,
+    SCANCODE_Z = 29,
+    SCANCODE_1 = 30,
+    SCANCODE_2 = 31,
+    SCANCODE_3 = 32,
+    SCANCODE_4 = 33
+};
+
 class Keyboard : public Component {
     private:
         uint8_t key;
@@ -26,7 +47,7 @@ class Keyboard : public Component {
 
         uint8_t getKey();
 
-        void storeKey(SDL_Scancode scancode);
+        void storeKey(uint16_t scancode);
 };
 
-#endif
\ No newline at end of file
+#endif
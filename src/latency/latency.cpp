@@ -0,0 +1,123 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Defines the input-to-photon latency probe.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <string>
+
+#include "latency.hpp"
+
+void LatencyHistogram::record(double us)
+{
+    samples.push_back(us);
+};
+
+std::size_t LatencyHistogram::count() const
+{
+    return samples.size();
+};
+
+double LatencyHistogram::percentile(double p) const
+{
+    if( samples.empty() ) return 0;
+
+    std::vector<double> sorted{samples};
+    std::sort(sorted.begin(), sorted.end());
+
+    const std::size_t rank{ static_cast<std::size_t>(std::ceil(p * sorted.size())) };
+    return sorted[std::min(std::max<std::size_t>(rank, 1), sorted.size()) - 1];
+};
+
+std::array<std::size_t, 32> LatencyHistogram::buckets() const
+{
+    std::array<std::size_t, 32> counts{};
+    for( double us : samples )
+    {
+        const int bucket{ (us < 1) ? 0 : static_cast<int>(std::log2(us)) };
+        ++counts[std::min(bucket, 31)];
+    }
+    return counts;
+};
+
+void LatencyProbe::advance(LatencyStage stage, LatencyClock::time_point now, Phase next)
+{
+    stages[static_cast<std::size_t>(stage)].record(std::chrono::duration<double, std::micro>(now - last).count());
+
+    last = now;
+    phase = next;
+};
+
+void LatencyProbe::keyPressed(LatencyClock::time_point pressed, LatencyClock::time_point polled)
+{
+    if( phase != Phase::IDLE ) ++abandoned;
+
+    this->pressed = pressed;
+    last = pressed;
+    advance(LatencyStage::QUEUE, polled, Phase::OBSERVE);
+};
+
+void LatencyProbe::keyObserved(LatencyClock::time_point now)
+{
+    if( phase == Phase::OBSERVE ) advance(LatencyStage::OBSERVE, now, Phase::DRAW);
+};
+
+void LatencyProbe::drawn(LatencyClock::time_point now)
+{
+    if( phase == Phase::DRAW ) advance(LatencyStage::DRAW, now, Phase::PRESENT);
+};
+
+void LatencyProbe::presented(LatencyClock::time_point now)
+{
+    if( phase != Phase::PRESENT ) return;
+
+    advance(LatencyStage::PRESENT, now, Phase::IDLE);
+    stages[static_cast<std::size_t>(LatencyStage::TOTAL)].record(
+        std::chrono::duration<double, std::micro>(now - pressed).count());
+};
+
+const LatencyHistogram& LatencyProbe::stage(LatencyStage stage) const
+{
+    return stages[static_cast<std::size_t>(stage)];
+};
+
+uint64_t LatencyProbe::abandonedCount() const
+{
+    return abandoned + (phase != Phase::IDLE);
+};
+
+void LatencyProbe::report(std::ostream& os) const
+{
+    const char* names[LATENCY_STAGES]{ "queue", "observe", "draw", "present", "total" };
+
+    os << "latency (us)   count      p50      p90      p99      max" << std::endl;
+    for( std::size_t s{0}; s < LATENCY_STAGES; ++s )
+    {
+        const LatencyHistogram& histogram{ stages[s] };
+        os << std::left << std::setw(12) << names[s] << std::right << std::fixed << std::setprecision(0)
+           << std::setw(8) << histogram.count() << std::setw(9) << histogram.percentile(0.5)
+           << std::setw(9) << histogram.percentile(0.9) << std::setw(9) << histogram.percentile(0.99)
+           << std::setw(9) << histogram.percentile(1) << std::endl;
+    }
+    os << "abandoned presses " << abandonedCount() << std::endl;
+
+    for( std::size_t s{0}; s < LATENCY_STAGES; ++s )
+    {
+        const std::array<std::size_t, 32> counts{ stages[s].buckets() };
+        const std::size_t peak{ *std::max_element(counts.begin(), counts.end()) };
+        if( peak == 0 ) continue;
+
+        os << names[s] << std::endl;
+        for( std::size_t b{0}; b < counts.size(); ++b )
+        {
+            if( counts[b] == 0 ) continue;
+
+            os << "  <" << std::setw(9) << (uint64_t{2} << b) << " us " << std::setw(6) << counts[b] << " "
+               << std::string((counts[b] * 40 + peak - 1) / peak, '#') << std::endl;
+        }
+    }
+};
@@ -0,0 +1,93 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Declares the input-to-photon latency probe. A key press is followed
+    through four stages: waiting in the SDL queue until it is polled, waiting
+    in the keyboard until an EX9E, EXA1 or FX0A reads it, the CPU running
+    until the next DXYN, and the draw waiting for the present that shows it.
+    Only one press is followed at a time, a press that arrives while another
+    is still in flight restarts the probe and the first one is abandoned.
+*/
+
+#ifndef LATENCY_H
+#define LATENCY_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+using LatencyClock = std::chrono::steady_clock;
+
+enum class LatencyStage
+{
+    QUEUE,
+    OBSERVE,
+    DRAW,
+    PRESENT,
+    TOTAL
+};
+
+#define LATENCY_STAGES 5
+
+// Microsecond samples of one stage, summarised when the report is printed.
+class LatencyHistogram
+{
+    private:
+        std::vector<double> samples{};
+
+    public:
+        void record(double us);
+
+        std::size_t count() const;
+
+        // Nearest rank percentile, p in [0, 1]. 0 when there are no samples.
+        double percentile(double p) const;
+
+        // Counts per power of two bucket, bucket b holding [2^b, 2^(b+1)) us.
+        std::array<std::size_t, 32> buckets() const;
+};
+
+class LatencyProbe
+{
+    private:
+        enum class Phase
+        {
+            IDLE,
+            OBSERVE,
+            DRAW,
+            PRESENT
+        };
+
+        Phase phase{Phase::IDLE};
+        LatencyClock::time_point pressed{};
+        LatencyClock::time_point last{};
+
+        std::array<LatencyHistogram, LATENCY_STAGES> stages{};
+        uint64_t abandoned{};
+
+        void advance(LatencyStage stage, LatencyClock::time_point now, Phase next);
+
+    public:
+        // A key went down at pressed and was taken off the event queue at polled.
+        void keyPressed(LatencyClock::time_point pressed, LatencyClock::time_point polled);
+
+        // The CPU read a held key.
+        void keyObserved(LatencyClock::time_point now);
+
+        void drawn(LatencyClock::time_point now);
+
+        // A frame reached the screen.
+        void presented(LatencyClock::time_point now);
+
+        const LatencyHistogram& stage(LatencyStage stage) const;
+
+        uint64_t abandonedCount() const;
+
+        void report(std::ostream& os) const;
+};
+
+#endif
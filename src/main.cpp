@@ -2,62 +2,242 @@
     Author: Min Kang
     Creation Date: January 7th, 2024
 
-    Entry point of the SDL executable. Sets up the event loop for the Chip8 interpreter.
+    Entry point of the executable. Sets up the event loop for the Chip8 interpreter,
+    either in an SDL window or headless with no SDL subsystem initialized.
+
+    Usage: main [--headless] [--frames N] [--profile auto|default|vip|chip48|schip|xochip]
+                [--capture file.y4m|file.ppm] [--capture-scaled] [--seed N]
+                [--latency] [--late-input] [--runahead N] [--stream unix:path|tcp:port]
+                [--rom-cache file] [--defer-draws] [rom file]
 */
 
+#ifdef CHIP8_SDL
 #include <SDL2/SDL.h>
+#endif
 
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
 #include <iostream>
 #include <random>
+#include <string>
+#include <vector>
 
 #include "header.hpp"
 #include "logger.hpp"
 #include "main.hpp"
+#include "capture.hpp"
+#include "library.hpp"
+#include "latency.hpp"
+#include "runahead.hpp"
 
-// Code from https://stackoverflow.com/questions/288739/generate-random-numbers-uniformly-over-an-entire-range
-std::random_device rand_dev{};
-std::mt19937 generator{rand_dev()};
-std::uniform_int_distribution<uint8_t> distr(0x00, 0xFF);
+#ifdef CHIP8_SDL
+#include "display.hpp"
+#endif
 
-uint8_t generateRandom() { return distr(generator); }
+#ifdef CHIP8_STREAM
+#include "stream.hpp"
+#endif
 
-MainBus::MainBus(SDL_Texture *texture) :
+MainBus::MainBus(uint64_t seed) :
     cpu(*this),
     keyboard(*this),
-    display(*this, texture, 0x00000000, 0xFFFFFFFF)
+    random(seed)
 {};
 
-Chip8&      MainBus::getCPU()       { return cpu;      };
-Keyboard&   MainBus::getKeyboard()  { return keyboard; };
-Display&    MainBus::getDisplay()   { return display;  };
+Chip8&          MainBus::getCPU()           { return cpu;         };
+Keyboard&       MainBus::getKeyboard()      { return keyboard;    };
+Framebuffer&    MainBus::getFramebuffer()   { return framebuffer; };
+Random&         MainBus::getRandom()        { return random;      };
+DrawList&       MainBus::getDrawList()      { return draws;       };
 
-void MainBus::notify(EventData event)
+void MainBus::setLatencyProbe(LatencyProbe* probe) { latency = probe; };
+
+void MainBus::setDeferredDraws(bool deferred)
+{
+    this->deferred = deferred;
+
+    // Nothing here replays the commands, only the shadow is presented.
+    draws.setRecording(false);
+    draws.reset(framebuffer);
+};
+
+bool MainBus::isDeferringDraws() const
+{
+    return deferred;
+};
+
+template<typename Target>
+void MainBus::display(Target& target, const EventData& event)
 {
     switch(event.type)
     {
         case EventType::DISPLAY_CLEAR:
-            display.clearScreen();
+            target.clearScreen(event.planes);
             break;
         case EventType::DISPLAY_DRAW:
             cpu.setStatusReg(
-                display.drawPixelData(
+                target.drawPixelData(
                     event.draw.xpos, 
                     event.draw.ypos, 
                     event.draw.data, 
-                    event.draw.size
+                    event.draw.size,
+                    event.draw.wrap,
+                    event.draw.wide,
+                    event.draw.planes
                 )
             );
             break;
+        case EventType::DISPLAY_SCROLL:
+            target.scroll(event.scroll.dx, event.scroll.dy, event.scroll.planes);
+            break;
+        case EventType::DISPLAY_MODE:
+            target.setHires(event.hires);
+            break;
+        default:
+            break;
+    }
+};
+
+void MainBus::notify(EventData event)
+{
+    switch(event.type)
+    {
+        case EventType::DISPLAY_DRAW:
+            if( latency ) latency->drawn( LatencyClock::now() );
+            [[fallthrough]];
+        case EventType::DISPLAY_CLEAR:
+        case EventType::DISPLAY_SCROLL:
+        case EventType::DISPLAY_MODE:
+            if( deferred ) display(draws, event);
+            else display(framebuffer, event);
+            break;
         case EventType::KEYBOARD_GET:
             (*event.key) = keyboard.getKey();
+            if( latency && *event.key != KEY_NOTPRESSED ) latency->keyObserved( LatencyClock::now() );
             break;
         case EventType::RANDOM: 
-            *event.random.dest = event.random.mask & generateRandom();
+            *event.random.dest = event.random.mask & random.next();
             break;
     }
 }
 
-int main( int argc, char* argv[] )
+// Every ROM, the built-in default relative to the working directory included,
+// is mapped through the library. With detected set, it receives the profile
+// the ROM's opcodes call for.
+bool loadRom(Chip8& cpu, const char* file, RomLibrary& library, Profile* detected)
+{
+    const std::string path{ file ? std::string{file}
+        : (std::filesystem::current_path() / "test" / "_data" / "chipquarium.ch8").string() };
+
+    const RomImage* image{ library.add(path) };
+    if( image == nullptr ) return false;
+
+    if( detected ) *detected = library.analysis(*image).profile;
+    return cpu.loadData(MEM_ADDR_START, image->data(), static_cast<int>(image->size()));
+}
+
+// Everything that takes a copy of each real frame. None of them waits on
+// its consumer, so they cost the emulation loop a copy of the planes.
+struct FrameOutputs
+{
+    Capture* capture{};
+#ifdef CHIP8_STREAM
+    StreamServer* stream{};
+#endif
+
+    void submit(const Framebuffer& framebuffer)
+    {
+        if( capture ) capture->submit(framebuffer);
+#ifdef CHIP8_STREAM
+        if( stream ) stream->publish(framebuffer);
+#endif
+    };
+
+    // Flushes the capture and reports whether the writer and viewers kept up.
+    void finish()
+    {
+        if( capture )
+        {
+            capture->close();
+            const CaptureStats stats{ capture->stats() };
+            std::cout << "capture written " << stats.written << " dropped " << stats.dropped
+                      << " max queue " << stats.max_queue_depth << std::endl;
+        }
+#ifdef CHIP8_STREAM
+        if( stream )
+        {
+            const StreamStats stats{ stream->stats() };
+            stream->close();
+            std::cout << "stream published " << stats.published << " sent " << stats.messages << " messages, "
+                      << stats.bytes << " bytes, coalesced " << stats.coalesced << " encode "
+                      << stats.encode_ns / std::max<uint64_t>(stats.messages, 1) << " ns/message" << std::endl;
+        }
+#endif
+    };
+};
+
+// Reports what the speculative frames cost on top of the real ones.
+void finishRunAhead(const RunAhead& runahead)
+{
+    if( runahead.getFrames() == 0 ) return;
+
+    const RunAheadStats& stats{ runahead.getStats() };
+    const uint64_t frames{ std::max<uint64_t>(stats.frames, 1) };
+    const uint64_t real_ns{ std::max<uint64_t>(stats.real_ns, 1) };
+    std::cout << "runahead " << runahead.getFrames() << " frames: real " << stats.real_ns / frames
+              << " ns/frame, speculative " << stats.speculative_ns / frames << " ns/frame, snapshots "
+              << stats.snapshot_ns / frames << " ns/frame, extra cpu "
+              << 100 * (stats.speculative_ns + stats.snapshot_ns) / real_ns << "%" << std::endl;
+}
+
+// Runs as fast as possible and prints the final framebuffer hash.
+int runHeadless(MainBus& main_bus, uint64_t frames, FrameOutputs& outputs, RunAhead& runahead)
+{
+    for(uint64_t frame{0}; frame < frames; ++frame)
+    {
+        runahead.step();
+
+        outputs.submit( main_bus.getFramebuffer() );
+    }
+    outputs.finish();
+    finishRunAhead(runahead);
+
+    std::cout << std::hex << "frames " << frames << " framebuffer " << main_bus.getFramebuffer().hash()
+              << " state " << main_bus.getCPU().hash() << std::dec << std::endl;
+    return 0;
+}
+
+#ifdef CHIP8_SDL
+// Returns false when the window was closed.
+bool handleEvent(const SDL_Event& event, MainBus& main_bus, LatencyProbe* latency, Logger& logger)
+{
+    switch(event.type) {
+        case SDL_QUIT:
+            return false;
+        case SDL_KEYDOWN:
+            main_bus.getKeyboard().storeKey( event.key.keysym.scancode );
+            logger << event.key.keysym.scancode << std::endl;
+
+            if( latency && !event.key.repeat )
+            {
+                // SDL stamps events in milliseconds since SDL_Init when they are queued.
+                const LatencyClock::time_point now{ LatencyClock::now() };
+                latency->keyPressed(now - std::chrono::milliseconds(SDL_GetTicks() - event.key.timestamp), now);
+            }
+            break;
+        case SDL_KEYUP:
+            main_bus.getKeyboard().storeKey( SDL_SCANCODE_UNKNOWN );
+            break;
+        default:
+            break;
+    }
+    return true;
+}
+
+int runWindowed(MainBus& main_bus, FrameOutputs& outputs, LatencyProbe* latency, bool late_input, RunAhead& runahead)
 {
     SDL_Init( SDL_INIT_EVERYTHING );
 
@@ -71,8 +251,8 @@ int main( int argc, char* argv[] )
     SDL_Texture *texture = SDL_CreateTexture(renderer, 
                                             SDL_PIXELFORMAT_ARGB8888, 
                                             SDL_TEXTUREACCESS_STREAMING, 
-                                            WIDTH,
-                                            HEIGHT);
+                                            HIRES_WIDTH,
+                                            HIRES_HEIGHT);
 
     SDL_RenderSetScale(renderer, SCALE, SCALE);
 
@@ -87,10 +267,9 @@ int main( int argc, char* argv[] )
         return 1;
     }
 
-    MainBus main_bus{texture};
+    Display display{texture, {0x00000000, 0xFFFFFFFF, 0xFFAAAAAA, 0xFF555555}};
 
-    main_bus.getCPU().loadProgram("\\test\\_data\\chipquarium.ch8");
-    // main_bus.getCPU().loadProgram("\\test\\_data\\fez.ch8");
+    main_bus.setLatencyProbe(latency);
 
     // Game Loop, idea from https://stackoverflow.com/questions/26664139/sdl-keydown-and-key-recognition-not-working-properly
     
@@ -101,37 +280,185 @@ int main( int argc, char* argv[] )
 
         while(SDL_PollEvent( &event ))
         {
-            switch(event.type) {
-                case SDL_QUIT:
-                    goto end_program;
-                case SDL_KEYDOWN:
-                    main_bus.getKeyboard().storeKey( event.key.keysym.scancode );
-                    std::cout << event.key.keysym.scancode << std::endl;
-                    break;
-                case SDL_KEYUP:
-                    main_bus.getKeyboard().storeKey( SDL_SCANCODE_UNKNOWN );    
-                    break;
-                default:
-                    break;
-            }
+            if( !handleEvent(event, main_bus, latency, logger) ) goto end_program;
         }
         
-        for(int i{0}; i < 10; ++i) {
-            main_bus.getCPU().execute( main_bus.getCPU().fetch() );
-        }
+        // Also ticks the timers. Capture and streaming get the real frames,
+        // not the speculative ones shown.
+        const Framebuffer& shown{ runahead.step() };
         
-        main_bus.getDisplay().updateScreen( renderer );
+        display.updateScreen( shown, renderer );
+        if( latency ) latency->presented( LatencyClock::now() );
+        outputs.submit( main_bus.getFramebuffer() );
 
-        uint32_t delay{ FRAMES_IN_MS - (SDL_GetTicks64() - prev) };
+        uint32_t delay{ static_cast<uint32_t>(FRAMES_IN_MS - (SDL_GetTicks64() - prev)) };
 
-        main_bus.getCPU().tickTimer();
+        if( !late_input )
+        {
+            SDL_Delay( (delay > FRAMES_IN_MS) ? 0 : delay );
+            continue;
+        }
 
-        SDL_Delay( (delay > FRAMES_IN_MS) ? 0 : delay );
+        // Waits on the event queue instead, handling presses as they arrive,
+        // but always until the frame deadline so the timers and the CPU stay
+        // at 60 Hz. The poll at the top of the loop then picks up anything
+        // queued since, right before the burst.
+        while( SDL_GetTicks64() - prev < FRAMES_IN_MS )
+        {
+            const int timeout{ static_cast<int>(FRAMES_IN_MS - (SDL_GetTicks64() - prev)) };
+            if( SDL_WaitEventTimeout(&event, timeout) && !handleEvent(event, main_bus, latency, logger) ) goto end_program;
+        }
     }
 
     end_program:
 
+    outputs.finish();
+    finishRunAhead(runahead);
+
+    main_bus.setLatencyProbe(nullptr);
+    if( latency ) latency->report(std::cout);
+
     SDL_DestroyWindow( window );
     SDL_Quit();
     return 0;
-}
\ No newline at end of file
+}
+#endif
+
+int main( int argc, char* argv[] )
+{
+    bool headless{false};
+    uint64_t frames{600};
+    Profile profile{Profile::DEFAULT};
+    bool detect_profile{false};
+    const char* rom_cache{nullptr};
+    const char* rom{nullptr};
+    const char* capture_path{nullptr};
+    const char* stream_address{nullptr};
+    std::size_t capture_scale{1};
+    uint64_t seed{ std::random_device{}() };
+    bool measure_latency{false};
+    bool late_input{false};
+    std::size_t runahead_frames{0};
+    bool defer_draws{false};
+
+    for(int i{1}; i < argc; ++i)
+    {
+        if( std::strcmp(argv[i], "--headless") == 0 )
+        {
+            headless = true;
+        }
+        else if( std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc )
+        {
+            frames = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if( std::strcmp(argv[i], "--profile") == 0 && i + 1 < argc )
+        {
+            detect_profile = std::strcmp(argv[++i], "auto") == 0;
+            if( !detect_profile && !profileFromName(argv[i], profile) )
+            {
+                std::cerr << "Unknown profile " << argv[i] << std::endl;
+                return 1;
+            }
+        }
+        else if( std::strcmp(argv[i], "--capture") == 0 && i + 1 < argc )
+        {
+            capture_path = argv[++i];
+        }
+        else if( std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc )
+        {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if( std::strcmp(argv[i], "--capture-scaled") == 0 )
+        {
+            capture_scale = SCALE;
+        }
+        else if( std::strcmp(argv[i], "--latency") == 0 )
+        {
+            measure_latency = true;
+        }
+        else if( std::strcmp(argv[i], "--late-input") == 0 )
+        {
+            late_input = true;
+        }
+        else if( std::strcmp(argv[i], "--stream") == 0 && i + 1 < argc )
+        {
+            stream_address = argv[++i];
+        }
+        else if( std::strcmp(argv[i], "--rom-cache") == 0 && i + 1 < argc )
+        {
+            rom_cache = argv[++i];
+        }
+        else if( std::strcmp(argv[i], "--defer-draws") == 0 )
+        {
+            defer_draws = true;
+        }
+        else if( std::strcmp(argv[i], "--runahead") == 0 && i + 1 < argc )
+        {
+            runahead_frames = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else
+        {
+            rom = argv[i];
+        }
+    }
+
+    MainBus main_bus{seed};
+
+    RomLibrary library{ rom_cache ? rom_cache : "" };
+    if( !loadRom(main_bus.getCPU(), rom, library, detect_profile ? &profile : nullptr) )
+    {
+        std::cerr << "Could not load " << (rom ? rom : "the default ROM") << std::endl;
+        return 1;
+    }
+    library.save();
+    main_bus.getCPU().setProfile(profile);
+
+    std::unique_ptr<Capture> capture{};
+    if( capture_path != nullptr )
+    {
+        capture = std::make_unique<Capture>(capture_path, capture_scale);
+        if( !capture->isOpen() )
+        {
+            std::cerr << "Could not open " << capture_path << std::endl;
+            return 1;
+        }
+    }
+
+    FrameOutputs outputs{};
+    outputs.capture = capture.get();
+
+#ifdef CHIP8_STREAM
+    std::unique_ptr<StreamServer> stream{};
+#endif
+    if( stream_address != nullptr )
+    {
+#ifdef CHIP8_STREAM
+        stream = std::make_unique<StreamServer>(stream_address);
+        outputs.stream = stream.get();
+        if( !stream->isOpen() )
+        {
+            std::cerr << "Could not listen on " << stream_address << std::endl;
+            return 1;
+        }
+#else
+        std::cerr << "Streaming is not supported on this platform" << std::endl;
+        return 1;
+#endif
+    }
+
+    main_bus.setDeferredDraws(defer_draws);
+    RunAhead runahead{main_bus.getCPU(), main_bus.getFramebuffer(), main_bus.getRandom(), runahead_frames,
+        defer_draws ? &main_bus.getDrawList() : nullptr};
+
+    if( headless && (measure_latency || late_input) )
+    {
+        std::cerr << "--latency and --late-input only apply to the window" << std::endl;
+    }
+
+#ifdef CHIP8_SDL
+    LatencyProbe latency{};
+    if( !headless ) return runWindowed(main_bus, outputs, measure_latency ? &latency : nullptr, late_input, runahead);
+#endif
+
+    return runHeadless(main_bus, frames, outputs, runahead);
+}
@@ -12,24 +12,48 @@
 
 #include "chip8.hpp"
 #include "keyboard.hpp"
-#include "display.hpp"
+#include "framebuffer.hpp"
+#include "drawlist.hpp"
 #include "bus.hpp"
+#include "random.hpp"
+#include "latency.hpp"
 
 class MainBus : public Bus
 {
     private:
         Chip8 cpu;
         Keyboard keyboard;
-        Display display;
+        Framebuffer framebuffer;
+        Random random;
+
+        // With deferred draws, display events go to draws and reach the
+        // framebuffer when RunAhead presents the frame.
+        DrawList draws;
+        bool deferred{false};
+
+        // Target is the framebuffer or the draw list.
+        template<typename Target>
+        void display(Target& target, const EventData& event);
+
+        LatencyProbe* latency{};
 
     public:
-        MainBus(SDL_Texture *texture);
+        // CXNN draws from random, so a fixed seed makes a run reproducible.
+        MainBus(uint64_t seed);
 
         void notify(EventData event);
 
         Chip8& getCPU();
         Keyboard& getKeyboard();
-        Display& getDisplay();
+        Framebuffer& getFramebuffer();
+        Random& getRandom();
+        DrawList& getDrawList();
+
+        void setDeferredDraws(bool deferred);
+        bool isDeferringDraws() const;
+
+        // Reports key reads and draws to the probe, nullptr to stop.
+        void setLatencyProbe(LatencyProbe* probe);
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,218 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Defines the ROM library and its cache file.
+*/
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <system_error>
+
+#include "library.hpp"
+
+static void storeLe(std::vector<uint8_t>& out, uint64_t value, std::size_t bytes)
+{
+    for( std::size_t i{0}; i < bytes; ++i ) out.push_back(static_cast<uint8_t>(value >> (8*i)));
+}
+
+// Reads bytes at offset, leaving value untouched and returning false past the end.
+static bool loadLe(const std::vector<uint8_t>& in, std::size_t& offset, std::size_t bytes, uint64_t& value)
+{
+    if( offset + bytes > in.size() ) return false;
+
+    value = 0;
+    for( std::size_t i{0}; i < bytes; ++i ) value |= static_cast<uint64_t>(in[offset + i]) << (8*i);
+    offset += bytes;
+    return true;
+}
+
+RomLibrary::RomLibrary(const std::string& cache_path) :
+    cache_path(cache_path)
+{
+    loadCache();
+};
+
+void RomLibrary::loadCache()
+{
+    if( cache_path.empty() ) return;
+
+    std::ifstream is{cache_path, std::ios_base::in | std::ios_base::binary};
+    if( !is.good() ) return;
+    const std::vector<uint8_t> file{ std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>() };
+
+    std::size_t offset{0};
+    uint64_t magic{}, version{}, records{};
+    if( !loadLe(file, offset, 4, magic) || !loadLe(file, offset, 4, version) || !loadLe(file, offset, 4, records)
+        || magic != ROM_CACHE_MAGIC || version != ROM_CACHE_VERSION ) return;
+
+    // A truncated record ends the load, the records before it are kept.
+    for( uint64_t r{0}; r < records; ++r )
+    {
+        uint64_t hash{}, size{}, profile{}, blocks{}, loops{}, modified{};
+        if( !loadLe(file, offset, 8, hash) || !loadLe(file, offset, 4, size) || !loadLe(file, offset, 1, profile)
+            || !loadLe(file, offset, 2, blocks) || !loadLe(file, offset, 2, loops) || !loadLe(file, offset, 2, modified)
+            || profile > static_cast<uint64_t>(Profile::XO_CHIP) ) return;
+
+        CacheSlot slot{ .from_disk = true };
+        slot.analysis.size = static_cast<uint32_t>(size);
+        slot.analysis.profile = static_cast<Profile>(profile);
+
+        for( uint64_t b{0}; b < blocks; ++b )
+        {
+            uint64_t start{}, end{};
+            if( !loadLe(file, offset, 2, start) || !loadLe(file, offset, 2, end) ) return;
+            slot.analysis.blocks.push_back({ static_cast<uint16_t>(start), static_cast<uint16_t>(end) });
+        }
+        for( uint64_t l{0}; l < loops; ++l )
+        {
+            uint64_t head{}, tail{}, flags{};
+            if( !loadLe(file, offset, 2, head) || !loadLe(file, offset, 2, tail) || !loadLe(file, offset, 1, flags) ) return;
+            slot.analysis.loops.push_back({ static_cast<uint16_t>(head), static_cast<uint16_t>(tail), static_cast<uint8_t>(flags) });
+        }
+        for( uint64_t m{0}; m < modified; ++m )
+        {
+            uint64_t start{}, end{};
+            if( !loadLe(file, offset, 2, start) || !loadLe(file, offset, 2, end) ) return;
+            slot.analysis.self_modifying.push_back({ static_cast<uint16_t>(start), static_cast<uint16_t>(end) });
+        }
+
+        cache.emplace(hash, std::move(slot));
+    }
+};
+
+std::size_t RomLibrary::scan(const std::string& directory)
+{
+    std::error_code error{};
+    std::filesystem::recursive_directory_iterator it{directory, error};
+    if( error ) return 0;
+
+    std::size_t added{0};
+    for( const std::filesystem::directory_entry& entry : it )
+    {
+        if( entry.is_regular_file(error) && entry.path().extension() == ROM_EXTENSION )
+        {
+            added += add(entry.path().string()) != nullptr;
+        }
+    }
+    return added;
+};
+
+const RomImage* RomLibrary::add(const std::string& path)
+{
+    std::unique_ptr<RomImage> image{ new RomImage(path) };
+    if( !image->isOpen() || image->size() > ROM_MAX_SIZE ) return nullptr;
+
+    images.push_back(std::move(image));
+    return images.back().get();
+};
+
+std::size_t RomLibrary::size() const
+{
+    return images.size();
+};
+
+const RomImage& RomLibrary::image(std::size_t index) const
+{
+    return *images[index];
+};
+
+const RomAnalysis& RomLibrary::analysis(const RomImage& image)
+{
+    return lookup(image.hash(), image.data(), image.size());
+};
+
+const RomAnalysis& RomLibrary::analysis(const uint8_t data[], std::size_t size)
+{
+    return lookup(romHash(data, size), data, size);
+};
+
+const RomAnalysis& RomLibrary::lookup(uint64_t hash, const uint8_t data[], std::size_t size)
+{
+    {
+        std::lock_guard<std::mutex> lock{cache_mutex};
+        auto found{ cache.find(hash) };
+        if( found != cache.end() && found->second.analysis.size == size )
+        {
+            if( found->second.from_disk ) ++counters.disk_hits;
+            else ++counters.memory_hits;
+
+            found->second.from_disk = false;
+            return found->second.analysis;
+        }
+    }
+
+    // Analysed without the lock; if another thread got there first its result is kept.
+    RomAnalysis result{ analyzeRom(data, size) };
+
+    std::lock_guard<std::mutex> lock{cache_mutex};
+    ++counters.analysed;
+    dirty = true;
+
+    CacheSlot& slot{ cache[hash] };
+    if( slot.analysis.size != size || slot.from_disk ) slot = { std::move(result), false };
+    return slot.analysis;
+};
+
+bool RomLibrary::save()
+{
+    std::lock_guard<std::mutex> lock{cache_mutex};
+    if( cache_path.empty() || !dirty ) return true;
+
+    std::vector<uint8_t> file{};
+    storeLe(file, ROM_CACHE_MAGIC, 4);
+    storeLe(file, ROM_CACHE_VERSION, 4);
+    storeLe(file, cache.size(), 4);
+
+    for( const auto& [hash, slot] : cache )
+    {
+        const RomAnalysis& analysis{ slot.analysis };
+        storeLe(file, hash, 8);
+        storeLe(file, analysis.size, 4);
+        storeLe(file, static_cast<uint64_t>(analysis.profile), 1);
+        storeLe(file, analysis.blocks.size(), 2);
+        storeLe(file, analysis.loops.size(), 2);
+        storeLe(file, analysis.self_modifying.size(), 2);
+
+        for( const RomBlock& block : analysis.blocks )
+        {
+            storeLe(file, block.start, 2);
+            storeLe(file, block.end, 2);
+        }
+        for( const RomLoop& loop : analysis.loops )
+        {
+            storeLe(file, loop.head, 2);
+            storeLe(file, loop.tail, 2);
+            storeLe(file, loop.flags, 1);
+        }
+        for( const AddressRange& range : analysis.self_modifying )
+        {
+            storeLe(file, range.start, 2);
+            storeLe(file, range.end, 2);
+        }
+    }
+
+    // Written beside the cache and renamed over it, so a reader never sees half a file.
+    const std::string temporary{ cache_path + ".tmp" };
+    {
+        std::ofstream os{temporary, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc};
+        os.write(reinterpret_cast<const char*>(file.data()), static_cast<std::streamsize>(file.size()));
+        if( !os.good() ) return false;
+    }
+
+    std::error_code error{};
+    std::filesystem::rename(temporary, cache_path, error);
+    if( error ) return false;
+
+    dirty = false;
+    return true;
+};
+
+RomLibraryStats RomLibrary::stats() const
+{
+    std::lock_guard<std::mutex> lock{cache_mutex};
+    RomLibraryStats stats{counters};
+    stats.roms = images.size();
+    return stats;
+};
@@ -0,0 +1,97 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Declares the ROM library. It maps every ROM of a directory and keeps the
+    analysis of each distinct ROM by content hash, in memory and in a cache
+    file that later runs load, so a ROM is analysed once however often and
+    under whatever name it is loaded. analysis() may be called from several
+    threads.
+
+    Cache file layout, multi-byte values little endian:
+
+        u32 magic "C8RC", u32 version, u32 records
+        records times:
+            u64 hash, u32 size, u8 profile, u16 blocks, u16 loops, u16 self_modifying
+            blocks times:         u16 start, u16 end
+            loops times:          u16 head, u16 tail, u8 flags
+            self_modifying times: u16 start, u16 end
+
+    A file of another version is ignored and rewritten on save.
+*/
+
+#ifndef LIBRARY_H
+#define LIBRARY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "rom.hpp"
+
+#define ROM_CACHE_MAGIC 0x43523843
+#define ROM_CACHE_VERSION 4
+#define ROM_EXTENSION ".ch8"
+
+struct RomLibraryStats
+{
+    std::size_t roms{};
+
+    // Where each analysis() call found its result.
+    uint64_t memory_hits{};
+    uint64_t disk_hits{};
+    uint64_t analysed{};
+};
+
+class RomLibrary
+{
+    private:
+        struct CacheSlot
+        {
+            RomAnalysis analysis{};
+
+            // Loaded from the cache file and not asked for yet.
+            bool from_disk{};
+        };
+
+        std::string cache_path{};
+        std::vector<std::unique_ptr<RomImage>> images{};
+
+        mutable std::mutex cache_mutex{};
+        std::unordered_map<uint64_t, CacheSlot> cache{};
+        bool dirty{};
+
+        RomLibraryStats counters{};
+
+        void loadCache();
+        const RomAnalysis& lookup(uint64_t hash, const uint8_t data[], std::size_t size);
+
+    public:
+        // An empty cache path keeps results in memory only.
+        RomLibrary(const std::string& cache_path = {});
+
+        // Maps every ROM_EXTENSION file below directory that fits in memory,
+        // returns how many were added.
+        std::size_t scan(const std::string& directory);
+
+        // Maps one file, returns nullptr if it cannot be read or is too large.
+        const RomImage* add(const std::string& path);
+
+        std::size_t size() const;
+        const RomImage& image(std::size_t index) const;
+
+        // Cached by content, analysed on the first request for a ROM no run has seen.
+        const RomAnalysis& analysis(const RomImage& image);
+        const RomAnalysis& analysis(const uint8_t data[], std::size_t size);
+
+        // Writes the cache file if anything was analysed since it was loaded.
+        bool save();
+
+        RomLibraryStats stats() const;
+};
+
+#endif
@@ -0,0 +1,128 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Defines ROM images and their cached analysis.
+*/
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "hash.hpp"
+#include "rom.hpp"
+
+uint64_t romHash(const uint8_t data[], std::size_t size)
+{
+    uint64_t hash{ mixHash(0x524F4D0000000000ULL ^ size) };
+
+    std::size_t i{0};
+    for( ; i + 8 <= size; i += 8 )
+    {
+        uint64_t word{};
+        std::memcpy(&word, data + i, 8);
+        hash = mixHash(hash ^ word);
+    }
+
+    uint64_t tail{0};
+    for( ; i < size; ++i ) tail = (tail << 8) | data[i];
+    return mixHash(hash ^ tail);
+}
+
+RomImage::RomImage(const std::string& path) :
+    path(path)
+{
+#ifdef _WIN32
+    std::ifstream is{path, std::ios_base::in | std::ios_base::binary};
+    if( !is.good() ) return;
+
+    buffer.assign(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+    bytes = buffer.data();
+    length = buffer.size();
+#else
+    const int fd{ ::open(path.c_str(), O_RDONLY) };
+    if( fd < 0 ) return;
+
+    struct stat info{};
+    if( ::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) )
+    {
+        ::close(fd);
+        return;
+    }
+
+    // An empty file cannot be mapped but is still a readable, empty ROM.
+    length = static_cast<std::size_t>(info.st_size);
+    if( length == 0 )
+    {
+        static const uint8_t empty{0};
+        bytes = &empty;
+        ::close(fd);
+        content_hash = romHash(bytes, 0);
+        return;
+    }
+
+    void* mapped{ ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0) };
+    ::close(fd);
+    if( mapped == MAP_FAILED )
+    {
+        length = 0;
+        return;
+    }
+    bytes = static_cast<const uint8_t*>(mapped);
+#endif
+
+    content_hash = romHash(bytes, length);
+};
+
+RomImage::~RomImage()
+{
+#ifndef _WIN32
+    if( bytes != nullptr && length > 0 ) ::munmap(const_cast<uint8_t*>(bytes), length);
+#endif
+};
+
+bool RomImage::isOpen() const
+{
+    return bytes != nullptr;
+};
+
+const std::string& RomImage::getPath() const
+{
+    return path;
+};
+
+const uint8_t* RomImage::data() const
+{
+    return bytes;
+};
+
+std::size_t RomImage::size() const
+{
+    return length;
+};
+
+uint64_t RomImage::hash() const
+{
+    return content_hash;
+};
+
+RomAnalysis analyzeRom(const uint8_t data[], std::size_t size)
+{
+    // Most ROMs need no second pass: only SUPER-CHIP and XO-CHIP opcodes change the profile.
+    ProgramAnalysis program{ analyzeProgram(data, size, Profile::DEFAULT) };
+    if( program.uses_xochip ) program = analyzeProgram(data, size, Profile::XO_CHIP);
+    else if( program.uses_schip ) program = analyzeProgram(data, size, Profile::SUPER_CHIP);
+
+    RomAnalysis analysis{ .size = static_cast<uint32_t>(size), .profile = program.profile };
+    for( const CfgBlock& block : program.blocks ) analysis.blocks.push_back({ block.start, block.end });
+    for( const ProgramLoop& loop : program.loops ) analysis.loops.push_back({ loop.head, loop.tail, loop.flags });
+    analysis.self_modifying = program.self_modifying;
+    return analysis;
+}
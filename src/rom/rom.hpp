@@ -0,0 +1,81 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Declares ROM images and what is derived from them. A RomImage maps a ROM
+    file read-only and identifies it by a hash of its contents, so the same
+    program under two names, or reloaded, is recognised. analyzeRom runs the
+    static analyzer under the profile the ROM's opcodes call for and keeps
+    the part of its results worth caching: the basic blocks, the loops and
+    the code that may be overwritten.
+*/
+
+#ifndef ROM_H
+#define ROM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "analyzer.hpp"
+
+uint64_t romHash(const uint8_t data[], std::size_t size);
+
+class RomImage
+{
+    private:
+        std::string path{};
+        const uint8_t* bytes{};
+        std::size_t length{};
+        uint64_t content_hash{};
+
+        // Only used where files cannot be mapped.
+        std::vector<uint8_t> buffer{};
+
+    public:
+        // Maps the whole file, isOpen is false if it cannot be read.
+        RomImage(const std::string& path);
+        ~RomImage();
+
+        RomImage(const RomImage&) = delete;
+        RomImage& operator=(const RomImage&) = delete;
+
+        bool isOpen() const;
+
+        const std::string& getPath() const;
+        const uint8_t* data() const;
+        std::size_t size() const;
+        uint64_t hash() const;
+};
+
+// Instructions from start up to, not including, end.
+struct RomBlock
+{
+    uint16_t start{};
+    uint16_t end{};
+};
+
+// ProgramLoop without its instruction count.
+struct RomLoop
+{
+    uint16_t head{};
+    uint16_t tail{};
+    uint8_t flags{};
+};
+
+struct RomAnalysis
+{
+    uint32_t size{};
+
+    // DEFAULT unless a reachable opcode only exists on SUPER-CHIP or XO-CHIP.
+    Profile profile{Profile::DEFAULT};
+
+    std::vector<RomBlock> blocks{};
+    std::vector<RomLoop> loops{};
+    std::vector<AddressRange> self_modifying{};
+};
+
+RomAnalysis analyzeRom(const uint8_t data[], std::size_t size);
+
+#endif
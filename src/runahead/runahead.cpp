@@ -0,0 +1,73 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Defines run-ahead.
+*/
+
+#include <chrono>
+
+#include "runahead.hpp"
+
+using RunAheadClock = std::chrono::steady_clock;
+
+static uint64_t elapsedNs(RunAheadClock::time_point start)
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(RunAheadClock::now() - start).count());
+}
+
+RunAhead::RunAhead(Chip8& cpu, Framebuffer& framebuffer, Random& random, std::size_t frames, DrawList* draws) :
+    cpu(cpu),
+    framebuffer(framebuffer),
+    random(random),
+    draws(draws),
+    frames(frames)
+{};
+
+void RunAhead::runFrame()
+{
+    cpu.cycle(INSTR_PER_FRAME);
+    cpu.tickTimer();
+
+    if( draws ) draws->present(framebuffer);
+};
+
+const Framebuffer& RunAhead::step()
+{
+    RunAheadClock::time_point start{ RunAheadClock::now() };
+    runFrame();
+    stats.real_ns += elapsedNs(start);
+    ++stats.frames;
+
+    if( frames == 0 ) return framebuffer;
+
+    start = RunAheadClock::now();
+    snapshot.cpu = cpu.getState();
+    snapshot.framebuffer = framebuffer;
+    snapshot.random = random;
+    stats.snapshot_ns += elapsedNs(start);
+
+    start = RunAheadClock::now();
+    for( std::size_t i{0}; i < frames; ++i ) runFrame();
+    shown = framebuffer;
+    stats.speculative_ns += elapsedNs(start);
+
+    start = RunAheadClock::now();
+    cpu.setState(snapshot.cpu);
+    framebuffer = snapshot.framebuffer;
+    random = snapshot.random;
+    if( draws ) draws->reset(framebuffer);
+    stats.snapshot_ns += elapsedNs(start);
+
+    return shown;
+};
+
+std::size_t RunAhead::getFrames() const
+{
+    return frames;
+};
+
+const RunAheadStats& RunAhead::getStats() const
+{
+    return stats;
+};
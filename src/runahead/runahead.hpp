@@ -0,0 +1,72 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Declares run-ahead, the RetroArch technique for hiding the frames a ROM
+    takes to react to input. Every frame runs for real, the machine is saved,
+    N more frames are run with the same keys held, and the last of those is
+    the one shown before the machine is restored. A snapshot is a plain copy
+    of the trivially copyable Chip8State, the bit packed framebuffer and the
+    random generator, a few kilobytes with no allocation.
+*/
+
+#ifndef RUNAHEAD_H
+#define RUNAHEAD_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "chip8.hpp"
+#include "framebuffer.hpp"
+#include "drawlist.hpp"
+#include "random.hpp"
+
+struct Snapshot
+{
+    Chip8State cpu{};
+    Framebuffer framebuffer{};
+    Random random{};
+};
+
+struct RunAheadStats
+{
+    uint64_t frames{};
+
+    // Time spent on real frames, speculative frames, and saving and restoring.
+    uint64_t real_ns{};
+    uint64_t speculative_ns{};
+    uint64_t snapshot_ns{};
+};
+
+class RunAhead
+{
+    private:
+        Chip8& cpu;
+        Framebuffer& framebuffer;
+        Random& random;
+        DrawList* draws{};
+
+        std::size_t frames{};
+
+        Snapshot snapshot{};
+        Framebuffer shown{};
+
+        RunAheadStats stats{};
+
+        void runFrame();
+
+    public:
+        // The machine is the cpu and everything its bus writes to. If the bus
+        // defers display events into draws, each frame is presented to the
+        // framebuffer as it ends.
+        RunAhead(Chip8& cpu, Framebuffer& framebuffer, Random& random, std::size_t frames, DrawList* draws = nullptr);
+
+        // Runs one real frame and returns the framebuffer to show, frames
+        // ahead of it. With 0 frames that is the real framebuffer.
+        const Framebuffer& step();
+
+        std::size_t getFrames() const;
+        const RunAheadStats& getStats() const;
+};
+
+#endif
@@ -0,0 +1,324 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Defines the content addressed savestate store.
+*/
+
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "hash.hpp"
+#include "savestate.hpp"
+
+#define CHUNK_RECORD_SIZE (1 + 8 + SAVE_CHUNK_SIZE)
+#define CHECKPOINT_RECORD_SIZE (1 + 4*SAVE_CHUNKS)
+
+// Where the registers chunk starts in the image.
+#define MACHINE_OFFSET (MEM_SIZE + SAVE_SCREEN_BYTES)
+
+static_assert(MEM_SIZE % SAVE_CHUNK_SIZE == 0 && SAVE_SCREEN_BYTES % SAVE_CHUNK_SIZE == 0,
+    "Memory and screen must split into whole chunks");
+
+static void storeLe(uint8_t out[], uint64_t value, std::size_t bytes)
+{
+    for( std::size_t i{0}; i < bytes; ++i ) out[i] = static_cast<uint8_t>(value >> (8*i));
+}
+
+static uint64_t loadLe(const uint8_t in[], std::size_t bytes)
+{
+    uint64_t value{0};
+    for( std::size_t i{0}; i < bytes; ++i ) value |= static_cast<uint64_t>(in[i]) << (8*i);
+    return value;
+}
+
+static uint64_t chunkHash(const uint8_t chunk[])
+{
+    uint64_t hash{ mixHash(0x43484E4B00000000ULL) };
+    for( std::size_t i{0}; i < SAVE_CHUNK_SIZE; i += 8 ) hash = mixHash(hash ^ loadLe(chunk + i, 8));
+    return hash;
+}
+
+void saveImage(const Snapshot& snapshot, uint8_t image[SAVE_IMAGE_SIZE])
+{
+    const Chip8State& cpu{ snapshot.cpu };
+    std::memcpy(image, cpu.memory.data(), MEM_SIZE);
+
+    // Lores only uses the first half of the first column, so the rest of
+    // the screen chunks stay zero and deduplicate.
+    uint8_t* out{ image + MEM_SIZE };
+    for( std::size_t p{0}; p < PLANES; ++p )
+    {
+        for( const auto& column : snapshot.framebuffer.getPlane(p) )
+        {
+            for( uint64_t word : column )
+            {
+                storeLe(out, word, 8);
+                out += 8;
+            }
+        }
+    }
+
+    uint8_t* machine{ image + MACHINE_OFFSET };
+    std::memset(machine, 0, SAVE_CHUNK_SIZE);
+    storeLe(machine, cpu.pc, 2);
+    storeLe(machine + 2, cpu.index_reg, 2);
+    std::memcpy(machine + 4, cpu.reg, 16);
+    machine[20] = cpu.sp;
+    machine[21] = cpu.delay;
+    machine[22] = cpu.sound;
+    machine[23] = cpu.planes;
+    for( std::size_t i{0}; i < 16; ++i ) storeLe(machine + 24 + 2*i, cpu.stack[i], 2);
+    std::memcpy(machine + 56, cpu.flags, 16);
+    machine[72] = snapshot.framebuffer.isHires();
+    storeLe(machine + 73, snapshot.random.state(), 8);
+}
+
+void loadImage(const uint8_t image[SAVE_IMAGE_SIZE], Snapshot& snapshot)
+{
+    Chip8State& cpu{ snapshot.cpu };
+    const uint8_t* machine{ image + MACHINE_OFFSET };
+
+    std::memcpy(cpu.memory.data(), image, MEM_SIZE);
+    cpu.rehashMemory();
+
+    cpu.pc = static_cast<uint16_t>(loadLe(machine, 2));
+    cpu.index_reg = static_cast<uint16_t>(loadLe(machine + 2, 2));
+    std::memcpy(cpu.reg, machine + 4, 16);
+    cpu.sp = machine[20];
+    cpu.delay = machine[21];
+    cpu.sound = machine[22];
+    cpu.planes = machine[23];
+    for( std::size_t i{0}; i < 16; ++i ) cpu.stack[i] = static_cast<uint16_t>(loadLe(machine + 24 + 2*i, 2));
+    std::memcpy(cpu.flags, machine + 56, 16);
+
+    snapshot.framebuffer.setHires(machine[72] != 0);
+    const uint8_t* in{ image + MEM_SIZE };
+    for( std::size_t p{0}; p < PLANES; ++p )
+    {
+        Framebuffer::Plane plane{};
+        for( auto& column : plane )
+        {
+            for( uint64_t& word : column )
+            {
+                word = loadLe(in, 8);
+                in += 8;
+            }
+        }
+        snapshot.framebuffer.setPlane(p, plane);
+    }
+
+    snapshot.random = Random::fromState(loadLe(machine + 73, 8));
+}
+
+SaveStore::SaveStore(const std::string& path, std::size_t group) :
+    path(path),
+    group(group)
+{
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if( fd < 0 ) return;
+
+    struct stat info{};
+    if( ::fstat(fd, &info) != 0 )
+    {
+        failed = true;
+        return;
+    }
+    file_size = static_cast<std::size_t>(info.st_size);
+
+    if( file_size == 0 )
+    {
+        pending.resize(SAVE_HEADER_SIZE);
+        storeLe(pending.data(), SAVE_PACK_MAGIC, 4);
+        storeLe(pending.data() + 4, SAVE_PACK_VERSION, 4);
+        return;
+    }
+
+    failed = !remap() || !scan();
+};
+
+SaveStore::~SaveStore()
+{
+    flush();
+    if( mapped ) ::munmap(const_cast<uint8_t*>(mapped), file_size);
+    if( fd >= 0 ) ::close(fd);
+};
+
+bool SaveStore::remap()
+{
+    // Callers unmap the old view while they still know its size.
+    mapped = nullptr;
+    if( file_size == 0 ) return true;
+
+    void* view{ ::mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fd, 0) };
+    if( view == MAP_FAILED ) return false;
+
+    mapped = static_cast<const uint8_t*>(view);
+    return true;
+};
+
+bool SaveStore::scan()
+{
+    if( file_size < SAVE_HEADER_SIZE || loadLe(mapped, 4) != SAVE_PACK_MAGIC
+        || loadLe(mapped + 4, 4) != SAVE_PACK_VERSION ) return false;
+
+    std::size_t offset{SAVE_HEADER_SIZE};
+    while( offset < file_size )
+    {
+        const uint8_t kind{ mapped[offset] };
+        if( kind == SAVE_RECORD_CHUNK && offset + CHUNK_RECORD_SIZE <= file_size )
+        {
+            const uint32_t id{ static_cast<uint32_t>(chunk_offsets.size()) };
+            chunk_ids.emplace(loadLe(mapped + offset + 1, 8), id);
+            chunk_offsets.push_back(offset + 9);
+            offset += CHUNK_RECORD_SIZE;
+        }
+        else if( kind == SAVE_RECORD_CHECKPOINT && offset + CHECKPOINT_RECORD_SIZE <= file_size )
+        {
+            checkpoint_offsets.push_back(offset + 1);
+            chunk_refs += SAVE_CHUNKS;
+            offset += CHECKPOINT_RECORD_SIZE;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    // A record cut short, or anything after it, is dropped so appends follow
+    // the last whole record.
+    if( offset < file_size )
+    {
+        ::munmap(const_cast<uint8_t*>(mapped), file_size);
+        mapped = nullptr;
+        if( ::ftruncate(fd, static_cast<off_t>(offset)) != 0 ) return false;
+        file_size = offset;
+        return remap();
+    }
+    return true;
+};
+
+const uint8_t* SaveStore::bytesAt(uint64_t offset) const
+{
+    return (offset < file_size) ? mapped + offset : pending.data() + (offset - file_size);
+};
+
+uint32_t SaveStore::addChunk(const uint8_t chunk[])
+{
+    const uint64_t hash{ chunkHash(chunk) };
+    auto found{ chunk_ids.find(hash) };
+    if( found != chunk_ids.end() && std::memcmp(bytesAt(chunk_offsets[found->second]), chunk, SAVE_CHUNK_SIZE) == 0 )
+    {
+        return found->second;
+    }
+
+    // A hash collision is stored again without an index entry.
+    const uint32_t id{ static_cast<uint32_t>(chunk_offsets.size()) };
+    if( found == chunk_ids.end() ) chunk_ids.emplace(hash, id);
+
+    const std::size_t record{ pending.size() };
+    pending.resize(record + CHUNK_RECORD_SIZE);
+    pending[record] = SAVE_RECORD_CHUNK;
+    storeLe(pending.data() + record + 1, hash, 8);
+    std::memcpy(pending.data() + record + 9, chunk, SAVE_CHUNK_SIZE);
+
+    chunk_offsets.push_back(file_size + record + 9);
+    return id;
+};
+
+bool SaveStore::isOpen() const
+{
+    return fd >= 0 && !failed;
+};
+
+uint64_t SaveStore::put(const Snapshot& snapshot)
+{
+    uint8_t image[SAVE_IMAGE_SIZE];
+    saveImage(snapshot, image);
+
+    uint32_t ids[SAVE_CHUNKS];
+    for( std::size_t c{0}; c < SAVE_CHUNKS; ++c ) ids[c] = addChunk(image + c*SAVE_CHUNK_SIZE);
+
+    const std::size_t record{ pending.size() };
+    pending.resize(record + CHECKPOINT_RECORD_SIZE);
+    pending[record] = SAVE_RECORD_CHECKPOINT;
+    for( std::size_t c{0}; c < SAVE_CHUNKS; ++c ) storeLe(pending.data() + record + 1 + 4*c, ids[c], 4);
+
+    const uint64_t checkpoint{ checkpoint_offsets.size() };
+    checkpoint_offsets.push_back(file_size + record + 1);
+    chunk_refs += SAVE_CHUNKS;
+
+    if( ++pending_checkpoints >= group ) flush();
+    return checkpoint;
+};
+
+bool SaveStore::get(uint64_t checkpoint, Snapshot& snapshot) const
+{
+    if( checkpoint >= checkpoint_offsets.size() ) return false;
+
+    const uint8_t* ids{ bytesAt(checkpoint_offsets[checkpoint]) };
+    uint8_t image[SAVE_IMAGE_SIZE];
+    for( std::size_t c{0}; c < SAVE_CHUNKS; ++c )
+    {
+        const uint64_t id{ loadLe(ids + 4*c, 4) };
+        if( id >= chunk_offsets.size() ) return false;
+        std::memcpy(image + c*SAVE_CHUNK_SIZE, bytesAt(chunk_offsets[id]), SAVE_CHUNK_SIZE);
+    }
+
+    loadImage(image, snapshot);
+    return true;
+};
+
+bool SaveStore::flush()
+{
+    if( !isOpen() ) return false;
+    if( pending.empty() ) return true;
+
+    std::size_t written{0};
+    while( written < pending.size() )
+    {
+        const ssize_t result{ ::pwrite(fd, pending.data() + written, pending.size() - written,
+            static_cast<off_t>(file_size + written)) };
+        if( result <= 0 )
+        {
+            failed = true;
+            return false;
+        }
+        written += static_cast<std::size_t>(result);
+    }
+    if( ::fsync(fd) != 0 )
+    {
+        failed = true;
+        return false;
+    }
+    ++syncs;
+
+    if( mapped ) ::munmap(const_cast<uint8_t*>(mapped), file_size);
+    mapped = nullptr;
+    file_size += pending.size();
+    pending.clear();
+    pending_checkpoints = 0;
+
+    failed = !remap();
+    return !failed;
+};
+
+std::size_t SaveStore::size() const
+{
+    return checkpoint_offsets.size();
+};
+
+SaveStoreStats SaveStore::stats() const
+{
+    SaveStoreStats stats{};
+    stats.checkpoints = checkpoint_offsets.size();
+    stats.chunk_refs = chunk_refs;
+    stats.chunks = chunk_offsets.size();
+    stats.pack_bytes = file_size + pending.size();
+    stats.syncs = syncs;
+    return stats;
+};
@@ -0,0 +1,126 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Declares the content addressed savestate store. A checkpoint of the
+    machine (cpu state, framebuffer and random generator, as in Snapshot) is
+    laid out as a fixed image and cut into SAVE_CHUNK_SIZE chunks: sixteen of
+    memory, eight of framebuffer words and one of registers. Each chunk is
+    stored once, under a hash of its contents, in a single append-only pack
+    file, and a checkpoint is the list of chunks it is made of. The font,
+    ROM pages and untouched screen areas of thousands of checkpoints then
+    take the space of one.
+
+    The pack starts with a header and holds two kinds of record:
+
+        chunk       u8 SAVE_RECORD_CHUNK, u64 hash, SAVE_CHUNK_SIZE bytes
+        checkpoint  u8 SAVE_RECORD_CHECKPOINT, SAVE_CHUNKS u32 chunk numbers
+
+    chunk numbers counting chunk records from 0, all values little endian.
+    A checkpoint only refers to chunks before it, so every whole prefix of
+    the pack is consistent. Opening scans the records into the in-memory
+    index and drops a record cut short by a crash.
+
+    New records are buffered and written, then fsynced, once per group of
+    checkpoints or on flush(). Reads go through a read-only mapping of the
+    pack, or the buffer for records not yet written. A store is used from
+    one thread.
+*/
+
+#ifndef SAVESTATE_H
+#define SAVESTATE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "runahead.hpp"
+
+#define SAVE_CHUNK_SIZE 256
+#define SAVE_MEMORY_CHUNKS (MEM_SIZE / SAVE_CHUNK_SIZE)
+#define SAVE_SCREEN_BYTES (PLANES * ROW_WORDS * HIRES_HEIGHT * 8)
+#define SAVE_SCREEN_CHUNKS (SAVE_SCREEN_BYTES / SAVE_CHUNK_SIZE)
+#define SAVE_CHUNKS (SAVE_MEMORY_CHUNKS + SAVE_SCREEN_CHUNKS + 1)
+#define SAVE_IMAGE_SIZE (SAVE_CHUNKS * SAVE_CHUNK_SIZE)
+
+#define SAVE_PACK_MAGIC 0x50533843
+#define SAVE_PACK_VERSION 1
+#define SAVE_HEADER_SIZE 8
+
+#define SAVE_RECORD_CHUNK 1
+#define SAVE_RECORD_CHECKPOINT 2
+
+// Checkpoints per write and fsync.
+#define SAVE_GROUP 256
+
+struct SaveStoreStats
+{
+    uint64_t checkpoints{};
+
+    // Chunks the checkpoints refer to, and the distinct ones stored.
+    uint64_t chunk_refs{};
+    uint64_t chunks{};
+
+    // Pack size, written or not, and the fsyncs it took.
+    uint64_t pack_bytes{};
+    uint64_t syncs{};
+};
+
+class SaveStore
+{
+    private:
+        std::string path{};
+        int fd{-1};
+        bool failed{false};
+
+        // The pack on disk is mapped whole; bytes past it wait in pending.
+        const uint8_t* mapped{};
+        std::size_t file_size{};
+        std::vector<uint8_t> pending{};
+        std::size_t pending_checkpoints{};
+        std::size_t group{};
+
+        // Offsets of each chunk's bytes and of each checkpoint's chunk list.
+        std::vector<uint64_t> chunk_offsets{};
+        std::vector<uint64_t> checkpoint_offsets{};
+        std::unordered_map<uint64_t, uint32_t> chunk_ids{};
+
+        uint64_t chunk_refs{};
+        uint64_t syncs{};
+
+        const uint8_t* bytesAt(uint64_t offset) const;
+        bool remap();
+        bool scan();
+        uint32_t addChunk(const uint8_t chunk[]);
+
+    public:
+        // Opens the pack at path, creating it if needed.
+        SaveStore(const std::string& path, std::size_t group = SAVE_GROUP);
+        ~SaveStore();
+
+        SaveStore(const SaveStore&) = delete;
+        SaveStore& operator=(const SaveStore&) = delete;
+
+        // False if the pack cannot be opened, is not a pack, or a write failed.
+        bool isOpen() const;
+
+        // Returns the checkpoint's number, counting from 0 in the pack.
+        uint64_t put(const Snapshot& snapshot);
+
+        // The framebuffer's hash is recomputed when next asked.
+        bool get(uint64_t checkpoint, Snapshot& snapshot) const;
+
+        // Writes and fsyncs whatever is buffered.
+        bool flush();
+
+        std::size_t size() const;
+        SaveStoreStats stats() const;
+};
+
+// The fixed image a checkpoint is cut from, and back.
+void saveImage(const Snapshot& snapshot, uint8_t image[SAVE_IMAGE_SIZE]);
+void loadImage(const uint8_t image[SAVE_IMAGE_SIZE], Snapshot& snapshot);
+
+#endif
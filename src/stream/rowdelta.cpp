@@ -0,0 +1,199 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Defines the row-delta frame encoding.
+    PackBits from https://en.wikipedia.org/wiki/PackBits
+*/
+
+#include <algorithm>
+
+#include "rowdelta.hpp"
+
+void packBits(const uint8_t in[], std::size_t size, std::vector<uint8_t>& out)
+{
+    std::size_t i{0};
+    while( i < size )
+    {
+        std::size_t run{1};
+        while( i + run < size && run < 128 && in[i + run] == in[i] ) ++run;
+
+        if( run >= 2 )
+        {
+            out.push_back(static_cast<uint8_t>(257 - run));
+            out.push_back(in[i]);
+            i += run;
+            continue;
+        }
+
+        // Literals up to the next run of two or more.
+        std::size_t count{1};
+        while( i + count < size && count < 128 && !(i + count + 1 < size && in[i + count] == in[i + count + 1]) ) ++count;
+
+        out.push_back(static_cast<uint8_t>(count - 1));
+        out.insert(out.end(), in + i, in + i + count);
+        i += count;
+    }
+}
+
+std::size_t unpackBits(const uint8_t in[], std::size_t available, uint8_t out[], std::size_t size)
+{
+    std::size_t read{0}, written{0};
+    while( written < size )
+    {
+        if( read >= available ) return 0;
+        const uint8_t control{ in[read++] };
+
+        if( control < 128 )
+        {
+            const std::size_t count{ static_cast<std::size_t>(control) + 1 };
+            if( read + count > available || written + count > size ) return 0;
+
+            std::copy(in + read, in + read + count, out + written);
+            read += count;
+            written += count;
+        }
+        else if( control > 128 )
+        {
+            const std::size_t count{ 257 - static_cast<std::size_t>(control) };
+            if( read >= available || written + count > size ) return 0;
+
+            std::fill_n(out + written, count, in[read++]);
+            written += count;
+        }
+    }
+    return read;
+}
+
+static void storeLe(uint8_t out[], uint32_t value, std::size_t bytes)
+{
+    for( std::size_t i{0}; i < bytes; ++i ) out[i] = static_cast<uint8_t>(value >> (8*i));
+}
+
+static uint32_t loadLe(const uint8_t in[], std::size_t bytes)
+{
+    uint32_t value{0};
+    for( std::size_t i{0}; i < bytes; ++i ) value |= static_cast<uint32_t>(in[i]) << (8*i);
+    return value;
+}
+
+bool RowDeltaEncoder::encode(const Planes& planes, bool hires, uint32_t sequence,
+    std::array<uint8_t, STREAM_HEADER_SIZE>& header, std::vector<uint8_t>& payload)
+{
+    const bool key{ keyframe || hires != last_hires };
+    const std::size_t rows{ static_cast<std::size_t>(hires ? HIRES_HEIGHT : HEIGHT) };
+    const std::size_t words{ hires ? ROW_WORDS : 1u };
+
+    payload.clear();
+    uint16_t count{0};
+
+    for( std::size_t p{0}; p < PLANES; ++p )
+    {
+        for( std::size_t y{0}; y < rows; ++y )
+        {
+            bool changed{key};
+            for( std::size_t w{0}; w < words && !changed; ++w ) changed = planes[p][w][y] != last[p][w][y];
+            if( !changed ) continue;
+
+            row_bytes.clear();
+            for( std::size_t w{0}; w < words; ++w )
+            {
+                for( int shift{56}; shift >= 0; shift -= 8 ) row_bytes.push_back(static_cast<uint8_t>(planes[p][w][y] >> shift));
+                last[p][w][y] = planes[p][w][y];
+            }
+
+            payload.push_back(static_cast<uint8_t>(p));
+            payload.push_back(static_cast<uint8_t>(y));
+            packBits(row_bytes.data(), row_bytes.size(), payload);
+            ++count;
+        }
+    }
+
+    if( count == 0 ) return false;
+
+    keyframe = false;
+    last_hires = hires;
+
+    storeLe(header.data(), static_cast<uint32_t>(STREAM_HEADER_SIZE - 4 + payload.size()), 4);
+    header[4] = static_cast<uint8_t>((hires ? STREAM_FLAG_HIRES : 0) | (key ? STREAM_FLAG_KEYFRAME : 0));
+    header[5] = 0;
+    storeLe(header.data() + 6, count, 2);
+    storeLe(header.data() + 8, sequence, 4);
+    return true;
+};
+
+void RowDeltaEncoder::reset()
+{
+    keyframe = true;
+};
+
+bool RowDeltaDecoder::apply(const uint8_t message[], std::size_t size)
+{
+    if( size < STREAM_HEADER_SIZE - 4 ) return false;
+
+    const bool message_hires{ (message[0] & STREAM_FLAG_HIRES) != 0 };
+    const std::size_t count{ loadLe(message + 2, 2) };
+    const std::size_t rows{ static_cast<std::size_t>(message_hires ? HIRES_HEIGHT : HEIGHT) };
+    const std::size_t words{ message_hires ? ROW_WORDS : 1u };
+
+    if( message[0] & STREAM_FLAG_KEYFRAME ) planes = {};
+    hires = message_hires;
+    sequence = loadLe(message + 4, 4);
+
+    std::size_t offset{ STREAM_HEADER_SIZE - 4 };
+    uint8_t row[8 * ROW_WORDS]{};
+    for( std::size_t r{0}; r < count; ++r )
+    {
+        if( offset + 2 > size ) return false;
+        const std::size_t p{ message[offset] }, y{ message[offset + 1] };
+        if( p >= PLANES || y >= rows ) return false;
+        offset += 2;
+
+        const std::size_t used{ unpackBits(message + offset, size - offset, row, 8*words) };
+        if( used == 0 ) return false;
+        offset += used;
+
+        for( std::size_t w{0}; w < words; ++w )
+        {
+            uint64_t word{0};
+            for( std::size_t b{0}; b < 8; ++b ) word = (word << 8) | row[8*w + b];
+            planes[p][w][y] = word;
+        }
+    }
+    return offset == size;
+};
+
+bool RowDeltaDecoder::isHires() const
+{
+    return hires;
+};
+
+std::size_t RowDeltaDecoder::width() const
+{
+    return hires ? HIRES_WIDTH : WIDTH;
+};
+
+std::size_t RowDeltaDecoder::height() const
+{
+    return hires ? HIRES_HEIGHT : HEIGHT;
+};
+
+uint32_t RowDeltaDecoder::getSequence() const
+{
+    return sequence;
+};
+
+uint8_t RowDeltaDecoder::pixel(std::size_t x, std::size_t y) const
+{
+    uint8_t colour{0};
+    for( std::size_t p{0}; p < PLANES; ++p )
+    {
+        colour |= static_cast<uint8_t>(((planes[p][x / 64][y] >> (63 - x % 64)) & 1) << p);
+    }
+    return colour;
+};
+
+const Planes& RowDeltaDecoder::getPlanes() const
+{
+    return planes;
+};
@@ -0,0 +1,89 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Declares the row-delta frame encoding used to stream the framebuffer.
+    A message carries only the rows of each plane that changed since the
+    previous message, each as its packed pixel bytes (8 per lores row, 16
+    per hires row, most significant bit leftmost) compressed with PackBits
+    run-length coding. A keyframe carries every row and is sent first and
+    after every mode switch.
+
+    Message layout, multi-byte values little endian:
+
+        u32 size          bytes that follow this field
+        u8  flags         bit 0 hires, bit 1 keyframe
+        u8  reserved
+        u16 rows          number of row records
+        u32 sequence      frames published before this one, so gaps show coalescing
+        rows times:
+            u8 plane, u8 y, PackBits data of the row
+*/
+
+#ifndef ROWDELTA_H
+#define ROWDELTA_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "framebuffer.hpp"
+
+#define STREAM_HEADER_SIZE 12
+#define STREAM_FLAG_HIRES 0x01
+#define STREAM_FLAG_KEYFRAME 0x02
+
+using Planes = std::array<Framebuffer::Plane, PLANES>;
+
+// PackBits: a control byte n below 128 is followed by n + 1 literal bytes,
+// n above 128 repeats the next byte 257 - n times.
+void packBits(const uint8_t in[], std::size_t size, std::vector<uint8_t>& out);
+
+// Decodes exactly size bytes into out, returns the input consumed or 0 if
+// the data ends early or overruns size.
+std::size_t unpackBits(const uint8_t in[], std::size_t available, uint8_t out[], std::size_t size);
+
+class RowDeltaEncoder
+{
+    private:
+        Planes last{};
+        bool last_hires{};
+        bool keyframe{true};
+
+        std::vector<uint8_t> row_bytes{};
+
+    public:
+        // Writes the header of the message into header and its row records
+        // into payload, which are sent back to back. Returns false, writing
+        // nothing, if no row changed since the last message.
+        bool encode(const Planes& planes, bool hires, uint32_t sequence,
+            std::array<uint8_t, STREAM_HEADER_SIZE>& header, std::vector<uint8_t>& payload);
+
+        // The next message is a keyframe.
+        void reset();
+};
+
+class RowDeltaDecoder
+{
+    private:
+        Planes planes{};
+        bool hires{};
+        uint32_t sequence{};
+
+    public:
+        // Applies one message without its size field. Returns false and
+        // leaves the frame unspecified if the message is malformed.
+        bool apply(const uint8_t message[], std::size_t size);
+
+        bool isHires() const;
+        std::size_t width() const;
+        std::size_t height() const;
+        uint32_t getSequence() const;
+
+        // Colour index of the pixel, one bit per plane.
+        uint8_t pixel(std::size_t x, std::size_t y) const;
+        const Planes& getPlanes() const;
+};
+
+#endif
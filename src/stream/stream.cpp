@@ -0,0 +1,361 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Defines the framebuffer stream server and client over POSIX sockets.
+*/
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "stream.hpp"
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+#define STREAM_MAX_MESSAGE (STREAM_HEADER_SIZE + PLANES * HIRES_HEIGHT * (2 + 2 * 8 * ROW_WORDS))
+
+static void setNonBlocking(int fd)
+{
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+}
+
+// Opens a listening (listen = true) or connected socket for the address.
+static int openSocket(const std::string& address, bool listen, std::string& unix_path)
+{
+    int fd{-1};
+
+    if( address.compare(0, 5, "unix:") == 0 )
+    {
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        unix_path = address.substr(5);
+        if( unix_path.empty() || unix_path.size() >= sizeof(addr.sun_path) ) return -1;
+        std::strncpy(addr.sun_path, unix_path.c_str(), sizeof(addr.sun_path) - 1);
+
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if( fd < 0 ) return -1;
+
+        if( listen ) ::unlink(unix_path.c_str());
+        const int result{ listen ? ::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr))
+                                 : ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) };
+        if( result != 0 || (listen && ::listen(fd, 16) != 0) )
+        {
+            ::close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    if( address.compare(0, 4, "tcp:") == 0 )
+    {
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(static_cast<uint16_t>(std::strtoul(address.c_str() + 4, nullptr, 10)));
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        fd = socket(AF_INET, SOCK_STREAM, 0);
+        if( fd < 0 ) return -1;
+
+        const int on{1};
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+
+        const int result{ listen ? ::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr))
+                                 : ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) };
+        if( result != 0 || (listen && ::listen(fd, 16) != 0) )
+        {
+            ::close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    return -1;
+}
+
+StreamServer::StreamServer(const std::string& address)
+{
+    listen_fd = openSocket(address, true, unix_path);
+    if( listen_fd < 0 ) return;
+    setNonBlocking(listen_fd);
+
+    int pipe_fds[2]{};
+    if( ::pipe(pipe_fds) != 0 )
+    {
+        ::close(listen_fd);
+        listen_fd = -1;
+        return;
+    }
+    wake_read = pipe_fds[0];
+    wake_write = pipe_fds[1];
+    setNonBlocking(wake_read);
+    setNonBlocking(wake_write);
+
+    sender = std::thread{ &StreamServer::senderLoop, this };
+};
+
+StreamServer::~StreamServer()
+{
+    close();
+};
+
+bool StreamServer::isOpen() const
+{
+    return sender.joinable();
+};
+
+void StreamServer::publish(const Framebuffer& framebuffer)
+{
+    if( !isOpen() ) return;
+
+    {
+        std::lock_guard<std::mutex> lock{latest_mutex};
+        for( std::size_t p{0}; p < PLANES; ++p ) latest[p] = framebuffer.getPlane(p);
+        latest_hires = framebuffer.isHires();
+        ++latest_sequence;
+    }
+    published.fetch_add(1, std::memory_order_relaxed);
+
+    // One wake byte in flight is enough, the sender always takes the newest frame.
+    if( !wake_pending.exchange(true) )
+    {
+        const uint8_t byte{1};
+        [[maybe_unused]] const ssize_t written{ ::write(wake_write, &byte, 1) };
+    }
+};
+
+void StreamServer::close()
+{
+    if( !isOpen() ) return;
+
+    stopping.store(true);
+    const uint8_t byte{1};
+    [[maybe_unused]] const ssize_t written{ ::write(wake_write, &byte, 1) };
+    sender.join();
+
+    for( const std::unique_ptr<Viewer>& viewer : viewers ) ::close(viewer->fd);
+    viewers.clear();
+    viewer_count.store(0);
+
+    ::close(listen_fd);
+    ::close(wake_read);
+    ::close(wake_write);
+    listen_fd = wake_read = wake_write = -1;
+
+    if( !unix_path.empty() ) ::unlink(unix_path.c_str());
+};
+
+StreamStats StreamServer::stats() const
+{
+    return {
+        .published = published.load(std::memory_order_relaxed),
+        .messages = messages.load(std::memory_order_relaxed),
+        .bytes = bytes.load(std::memory_order_relaxed),
+        .coalesced = coalesced.load(std::memory_order_relaxed),
+        .encode_ns = encode_ns.load(std::memory_order_relaxed),
+        .viewers = viewer_count.load(std::memory_order_relaxed)
+    };
+};
+
+void StreamServer::acceptViewers()
+{
+    while( true )
+    {
+        const int fd{ ::accept(listen_fd, nullptr, nullptr) };
+        if( fd < 0 ) return;
+
+        setNonBlocking(fd);
+        const int on{1};
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+#ifdef SO_NOSIGPIPE
+        setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+
+        std::unique_ptr<Viewer> viewer{ new Viewer{} };
+        viewer->fd = fd;
+        viewers.push_back(std::move(viewer));
+    }
+};
+
+bool StreamServer::flush(Viewer& viewer)
+{
+    while( viewer.sent < viewer.total )
+    {
+        // Header and payload go out in one call without being joined first.
+        iovec parts[2]{};
+        std::size_t count{0};
+        if( viewer.sent < STREAM_HEADER_SIZE )
+        {
+            parts[count++] = { viewer.header.data() + viewer.sent, STREAM_HEADER_SIZE - viewer.sent };
+            parts[count++] = { viewer.payload.data(), viewer.payload.size() };
+        }
+        else
+        {
+            const std::size_t offset{ viewer.sent - STREAM_HEADER_SIZE };
+            parts[count++] = { viewer.payload.data() + offset, viewer.payload.size() - offset };
+        }
+
+        msghdr message{};
+        message.msg_iov = parts;
+        message.msg_iovlen = count;
+
+        const ssize_t written{ ::sendmsg(viewer.fd, &message, MSG_NOSIGNAL | MSG_DONTWAIT) };
+        if( written < 0 )
+        {
+            if( errno == EINTR ) continue;
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+
+        viewer.sent += static_cast<std::size_t>(written);
+        bytes.fetch_add(static_cast<uint64_t>(written), std::memory_order_relaxed);
+    }
+
+    messages.fetch_add(1, std::memory_order_relaxed);
+    return true;
+};
+
+void StreamServer::senderLoop()
+{
+    Planes frame{};
+    bool hires{};
+    uint32_t sequence{0};
+
+    std::vector<pollfd> fds{};
+    while( !stopping.load() )
+    {
+        fds.clear();
+        fds.push_back({ wake_read, POLLIN, 0 });
+        fds.push_back({ listen_fd, POLLIN, 0 });
+        for( const std::unique_ptr<Viewer>& viewer : viewers )
+        {
+            fds.push_back({ viewer->fd, static_cast<short>((viewer->sent < viewer->total) ? POLLOUT : 0), 0 });
+        }
+
+        if( ::poll(fds.data(), fds.size(), 100) < 0 && errno != EINTR ) break;
+
+        if( fds[0].revents & POLLIN )
+        {
+            uint8_t drain[64];
+            while( ::read(wake_read, drain, sizeof(drain)) > 0 ) {}
+            wake_pending.store(false);
+        }
+        if( fds[1].revents & POLLIN ) acceptViewers();
+
+        {
+            std::lock_guard<std::mutex> lock{latest_mutex};
+            if( latest_sequence != sequence )
+            {
+                frame = latest;
+                hires = latest_hires;
+                sequence = latest_sequence;
+            }
+        }
+
+        for( std::size_t i{0}; i < viewers.size(); ++i )
+        {
+            Viewer& viewer{ *viewers[i] };
+            const short revents{ (i + 2 < fds.size()) ? fds[i + 2].revents : short{0} };
+
+            bool alive{ (revents & (POLLHUP | POLLERR | POLLNVAL)) == 0 };
+            if( alive && viewer.sent < viewer.total ) alive = flush(viewer);
+
+            // Still writing the last message, this frame is skipped.
+            if( alive && viewer.sent < viewer.total ) continue;
+
+            // A new viewer starts with a keyframe of whatever was published last.
+            const bool fresh{ viewer.total == 0 };
+            if( alive && (fresh ? sequence > 0 : viewer.sequence != sequence) )
+            {
+                if( !fresh && sequence - viewer.sequence > 1 )
+                {
+                    coalesced.fetch_add(sequence - viewer.sequence - 1, std::memory_order_relaxed);
+                }
+
+                const auto start{ std::chrono::steady_clock::now() };
+                const bool changed{ viewer.encoder.encode(frame, hires, sequence, viewer.header, viewer.payload) };
+                encode_ns.fetch_add(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start).count()), std::memory_order_relaxed);
+
+                viewer.sequence = sequence;
+                if( changed )
+                {
+                    viewer.sent = 0;
+                    viewer.total = STREAM_HEADER_SIZE + viewer.payload.size();
+                    alive = flush(viewer);
+                }
+            }
+
+            if( !alive )
+            {
+                ::close(viewer.fd);
+                viewers.erase(viewers.begin() + static_cast<std::ptrdiff_t>(i));
+                --i;
+            }
+        }
+        viewer_count.store(viewers.size(), std::memory_order_relaxed);
+    }
+};
+
+StreamClient::StreamClient(const std::string& address)
+{
+    std::string unix_path{};
+    fd = openSocket(address, false, unix_path);
+};
+
+StreamClient::~StreamClient()
+{
+    if( fd >= 0 ) ::close(fd);
+};
+
+bool StreamClient::isOpen() const
+{
+    return fd >= 0;
+};
+
+bool StreamClient::readFully(uint8_t out[], std::size_t size)
+{
+    std::size_t got{0};
+    while( got < size )
+    {
+        const ssize_t result{ ::read(fd, out + got, size - got) };
+        if( result < 0 && errno == EINTR ) continue;
+        if( result <= 0 ) return false;
+        got += static_cast<std::size_t>(result);
+    }
+    return true;
+};
+
+bool StreamClient::receive(RowDeltaDecoder& decoder)
+{
+    if( fd < 0 ) return false;
+
+    uint8_t size_bytes[4]{};
+    if( !readFully(size_bytes, 4) ) return false;
+
+    const std::size_t size{ size_bytes[0] | (size_bytes[1] << 8) | (static_cast<std::size_t>(size_bytes[2]) << 16)
+        | (static_cast<std::size_t>(size_bytes[3]) << 24) };
+    if( size > STREAM_MAX_MESSAGE ) return false;
+
+    message.resize(size);
+    if( !readFully(message.data(), size) ) return false;
+
+    return decoder.apply(message.data(), size);
+};
+
+std::size_t StreamClient::lastSize() const
+{
+    return message.size() + 4;
+};
@@ -0,0 +1,138 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Declares the framebuffer stream server and client. The emulation thread
+    publishes frames by copying the bit packed planes into a single latest
+    frame slot; a sender thread encodes them as row-delta messages (see
+    rowdelta.hpp) for every connected viewer and writes header and payload
+    with one scatter write. Sockets never block: a viewer that has not taken
+    its last message is skipped, and once it catches up its next message is
+    the delta to the newest frame, so it sees coalesced frames and the
+    emulator never waits for it.
+
+    Addresses are "unix:/path/to/socket" or "tcp:port" on 127.0.0.1.
+    POSIX only.
+*/
+
+#ifndef STREAM_H
+#define STREAM_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "framebuffer.hpp"
+#include "rowdelta.hpp"
+
+struct StreamStats
+{
+    uint64_t published{};
+
+    // Messages and bytes written over all viewers, and frames a viewer
+    // missed because it had not taken the previous message yet.
+    uint64_t messages{};
+    uint64_t bytes{};
+    uint64_t coalesced{};
+
+    uint64_t encode_ns{};
+    std::size_t viewers{};
+};
+
+class StreamServer
+{
+    private:
+        struct Viewer
+        {
+            int fd{-1};
+            RowDeltaEncoder encoder{};
+
+            std::array<uint8_t, STREAM_HEADER_SIZE> header{};
+            std::vector<uint8_t> payload{};
+
+            // Bytes of header + payload already written, pending while below their sum.
+            std::size_t sent{};
+            std::size_t total{};
+            uint32_t sequence{};
+        };
+
+        int listen_fd{-1};
+        std::string unix_path{};
+
+        // The self pipe that wakes the sender when a frame is published.
+        int wake_read{-1};
+        int wake_write{-1};
+        std::atomic<bool> wake_pending{false};
+
+        std::mutex latest_mutex{};
+        Planes latest{};
+        bool latest_hires{};
+        uint32_t latest_sequence{};
+
+        std::vector<std::unique_ptr<Viewer>> viewers{};
+
+        std::atomic<uint64_t> published{0};
+        std::atomic<uint64_t> messages{0};
+        std::atomic<uint64_t> bytes{0};
+        std::atomic<uint64_t> coalesced{0};
+        std::atomic<uint64_t> encode_ns{0};
+        std::atomic<std::size_t> viewer_count{0};
+
+        std::atomic<bool> stopping{false};
+        std::thread sender{};
+
+        void senderLoop();
+        void acceptViewers();
+
+        // Returns false if the viewer disconnected.
+        bool flush(Viewer& viewer);
+
+    public:
+        StreamServer(const std::string& address);
+        ~StreamServer();
+
+        StreamServer(const StreamServer&) = delete;
+        StreamServer& operator=(const StreamServer&) = delete;
+
+        bool isOpen() const;
+
+        // Copies the planes for the sender, never waits on a viewer.
+        void publish(const Framebuffer& framebuffer);
+
+        void close();
+
+        StreamStats stats() const;
+};
+
+class StreamClient
+{
+    private:
+        int fd{-1};
+        std::vector<uint8_t> message{};
+
+        bool readFully(uint8_t out[], std::size_t size);
+
+    public:
+        StreamClient(const std::string& address);
+        ~StreamClient();
+
+        StreamClient(const StreamClient&) = delete;
+        StreamClient& operator=(const StreamClient&) = delete;
+
+        bool isOpen() const;
+
+        // Blocks for the next message and applies it. Returns false when the
+        // server is gone or sent a malformed message.
+        bool receive(RowDeltaDecoder& decoder);
+
+        // Size of the last message received, size field included.
+        std::size_t lastSize() const;
+};
+
+#endif
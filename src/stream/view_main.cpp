@@ -0,0 +1,85 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Entry point of the reference stream viewer. Connects to a framebuffer
+    stream and draws it in the terminal, two pixel rows per character cell,
+    then reports the bandwidth it received.
+
+    Usage: chip8_view [--quiet] [--frames N] unix:/path | tcp:port
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "stream.hpp"
+
+// Upper half, lower half and full block.
+const char* const BLOCKS[4]{ " ", "▀", "▄", "█" };
+
+void draw(const RowDeltaDecoder& decoder)
+{
+    std::string screen{"\x1b[H"};
+    for( std::size_t y{0}; y < decoder.height(); y += 2 )
+    {
+        for( std::size_t x{0}; x < decoder.width(); ++x )
+        {
+            const bool top{ decoder.pixel(x, y) != 0 }, bottom{ decoder.pixel(x, y + 1) != 0 };
+            screen += BLOCKS[top | (bottom << 1)];
+        }
+        screen += "\x1b[K\n";
+    }
+    std::cout << screen << "\x1b[J" << std::flush;
+}
+
+int main( int argc, char* argv[] )
+{
+    const char* address{nullptr};
+    bool quiet{false};
+    uint64_t frames{0};
+
+    for( int i{1}; i < argc; ++i )
+    {
+        if( std::strcmp(argv[i], "--quiet") == 0 ) quiet = true;
+        else if( std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc ) frames = std::strtoull(argv[++i], nullptr, 10);
+        else address = argv[i];
+    }
+
+    if( address == nullptr )
+    {
+        std::cerr << "Usage: chip8_view [--quiet] [--frames N] unix:/path | tcp:port" << std::endl;
+        return 2;
+    }
+
+    StreamClient client{address};
+    if( !client.isOpen() )
+    {
+        std::cerr << "Could not connect to " << address << std::endl;
+        return 1;
+    }
+
+    RowDeltaDecoder decoder{};
+    uint64_t received{0}, bytes{0};
+    uint32_t first{0};
+
+    const auto start{ std::chrono::steady_clock::now() };
+    while( (frames == 0 || received < frames) && client.receive(decoder) )
+    {
+        if( received++ == 0 ) first = decoder.getSequence();
+        bytes += client.lastSize();
+
+        if( !quiet ) draw(decoder);
+    }
+    const double seconds{ std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() };
+
+    // Sequence numbers count every published frame, including coalesced ones.
+    const uint64_t spanned{ (received > 0) ? decoder.getSequence() - first + 1 : 0 };
+    std::cout << "received " << received << " messages covering " << spanned << " frames, " << bytes << " bytes, "
+              << (received ? bytes / received : 0) << " bytes/message, " << static_cast<uint64_t>(bytes / std::max(seconds, 1e-9))
+              << " bytes/s" << std::endl;
+    return 0;
+}
@@ -0,0 +1,224 @@
+/*
+    Author: Min Kang
+    Creation Date: October 19th, 2026
+
+    Runs every ROM listed in a conformance manifest headless, all at once on a
+    worker pool, and compares the hash of each final state and framebuffer
+    against the golden hash checked in next to it. Each manifest line reads
+
+        rom profile frames input hash
+
+    where rom is relative to the manifest, frames is how many frames to run
+    (fewer if the ROM halts), input is "-" or a comma separated list of
+    frame:keys steps holding the hex key mask from that frame on, and hash
+    is the golden hash in hex or "-" when none has been recorded yet.
+
+    Usage: conformance_tests manifest.txt [--threads N] [--update]
+
+    --update rewrites the manifest with the hashes of this run.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "env.hpp"
+#include "quirks.hpp"
+#include "workers.hpp"
+
+#define CONFORMANCE_SEED 0xC8
+
+struct InputStep
+{
+    std::size_t frame{};
+    uint16_t keys{};
+};
+
+struct Entry
+{
+    std::size_t line{};
+    std::string rom{};
+    Profile profile{};
+    std::size_t frames{};
+    std::vector<InputStep> input{};
+    std::string expected{};
+
+    std::string error{};
+    uint64_t hash{};
+    std::size_t frames_run{};
+};
+
+bool parseInput(const std::string& text, std::vector<InputStep>& input)
+{
+    if( text == "-" ) return true;
+
+    std::istringstream is{text};
+    for( std::string step{}; std::getline(is, step, ','); )
+    {
+        const std::size_t colon{ step.find(':') };
+        if( colon == std::string::npos ) return false;
+
+        char *end{};
+        const std::size_t frame{ std::strtoul(step.c_str(), &end, 10) };
+        if( end != step.c_str() + colon ) return false;
+
+        const unsigned long keys{ std::strtoul(step.c_str() + colon + 1, &end, 16) };
+        if( *end != '\0' || keys > 0xFFFF ) return false;
+        if( !input.empty() && frame <= input.back().frame ) return false;
+
+        input.push_back({ frame, static_cast<uint16_t>(keys) });
+    }
+    return true;
+}
+
+void runEntry(Entry& entry, const std::string& directory)
+{
+    std::ifstream is{directory + entry.rom, std::ios_base::in | std::ios_base::binary};
+    if( !is.is_open() )
+    {
+        entry.error = "cannot read rom";
+        return;
+    }
+
+    const std::vector<uint8_t> rom{ std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>() };
+    if( rom.size() > MEM_ADDR_END - MEM_ADDR_START )
+    {
+        entry.error = "rom too large";
+        return;
+    }
+
+    std::unique_ptr<EnvInstance> instance{ new EnvInstance(CONFORMANCE_SEED) };
+    instance->reset(rom.data(), rom.size(), entry.profile);
+
+    // One frame at a time, holding the keys of the latest input step.
+    std::size_t step{0};
+    uint16_t keys{0};
+    for( ; entry.frames_run < entry.frames && !instance->isDone(); ++entry.frames_run )
+    {
+        while( step < entry.input.size() && entry.input[step].frame <= entry.frames_run ) keys = entry.input[step++].keys;
+
+        instance->advance(keys, 1, 0);
+    }
+
+    entry.hash = instance->hash();
+};
+
+struct Suite
+{
+    std::vector<Entry> *entries{};
+    std::string directory{};
+};
+
+void runSlice(void *context, std::size_t begin, std::size_t end)
+{
+    Suite& suite{ *static_cast<Suite*>(context) };
+    for( std::size_t i{begin}; i < end; ++i ) runEntry((*suite.entries)[i], suite.directory);
+};
+
+std::string hexHash(uint64_t hash)
+{
+    std::ostringstream os{};
+    os << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return os.str();
+}
+
+int main( int argc, char* argv[] )
+{
+    std::string manifest{};
+    std::size_t threads{0};
+    bool update{false};
+
+    for( int i{1}; i < argc; ++i )
+    {
+        if( std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc ) threads = std::strtoul(argv[++i], nullptr, 10);
+        else if( std::strcmp(argv[i], "--update") == 0 ) update = true;
+        else if( manifest.empty() ) manifest = argv[i];
+        else
+        {
+            std::cerr << "Unknown argument " << argv[i] << std::endl;
+            return 2;
+        }
+    }
+
+    std::ifstream is{manifest};
+    if( manifest.empty() || !is.good() )
+    {
+        std::cerr << "Usage: conformance_tests manifest.txt [--threads N] [--update]" << std::endl;
+        return 2;
+    }
+
+    std::vector<std::string> lines{};
+    std::vector<Entry> entries{};
+    for( std::string line{}; std::getline(is, line); )
+    {
+        lines.push_back(line);
+
+        std::istringstream fields{line};
+        std::string rom{}, profile{}, input{}, expected{};
+        std::size_t frames{};
+        if( !(fields >> rom) || rom[0] == '#' ) continue;
+
+        Entry entry{ .line = lines.size() - 1, .rom = rom };
+        if( !(fields >> profile >> frames >> input >> expected) || !profileFromName(profile, entry.profile)
+            || !parseInput(input, entry.input) )
+        {
+            std::cerr << manifest << ":" << lines.size() << ": malformed entry" << std::endl;
+            return 2;
+        }
+        entry.frames = frames;
+        entry.expected = expected;
+        entries.push_back(entry);
+    }
+
+    const std::size_t slash{ manifest.find_last_of("/\\") };
+    Suite suite{ &entries, (slash == std::string::npos) ? std::string{} : manifest.substr(0, slash + 1) };
+
+    const std::size_t hardware{ std::max<std::size_t>(std::thread::hardware_concurrency(), 1) };
+    WorkerPool workers{ std::max<std::size_t>(std::min(threads == 0 ? hardware : threads, entries.size()), 1) };
+
+    const auto start{ std::chrono::steady_clock::now() };
+    workers.dispatch(runSlice, &suite, entries.size());
+    const double elapsed{ std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() };
+
+    std::size_t failed{0};
+    for( Entry& entry : entries )
+    {
+        const std::string actual{ hexHash(entry.hash) };
+        const bool passed{ entry.error.empty() && (update || actual == entry.expected) };
+        failed += !passed;
+
+        std::cout << (passed ? "PASS " : "FAIL ") << std::left << std::setw(24) << entry.rom << std::right;
+        if( !entry.error.empty() ) std::cout << " " << entry.error << std::endl;
+        else std::cout << " " << std::setw(5) << entry.frames_run << " frames  " << actual
+                       << ((passed || entry.expected == "-") ? "" : "  expected " + entry.expected) << std::endl;
+
+        if( update && entry.error.empty() )
+        {
+            // The hash is the last field, everything before it is kept.
+            std::string& line{ lines[entry.line] };
+            line = line.substr(0, line.rfind(entry.expected)) + actual;
+        }
+    }
+
+    std::cout << entries.size() - failed << "/" << entries.size() << " passed in " << std::fixed << std::setprecision(1)
+              << elapsed << " ms on " << workers.size() << " threads" << std::endl;
+
+    if( update )
+    {
+        std::ofstream os{manifest};
+        for( const std::string& line : lines ) os << line << "\n";
+    }
+
+    return failed > 0 ? 1 : 0;
+}
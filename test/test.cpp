@@ -6,13 +6,48 @@
 */
 
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#ifndef DEBUG_OFF
 #define DEBUG_OFF
+#endif
 
 #include <doctest/doctest.h>
 
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include "logger.hpp"
 #include "bus.hpp"
 #include "chip8.hpp"
+#include "pool.hpp"
+#include "debugger.hpp"
+#include "analyzer.hpp"
+#include "env.hpp"
+#include "hash.hpp"
+#include "framebuffer.hpp"
+#include "drawlist.hpp"
+#include "keyboard.hpp"
+#include "capture.hpp"
+#include "fuzz.hpp"
+#include "latency.hpp"
+#include "random.hpp"
+#include "runahead.hpp"
+#include "host.hpp"
+#include "library.hpp"
+
+#ifdef CHIP8_STREAM
+#include "rowdelta.hpp"
+#include "stream.hpp"
+#endif
+
+#ifdef CHIP8_SAVESTATE
+#include "savestate.hpp"
+#endif
 
 class MockBus : public Bus
 {
@@ -257,7 +292,1229 @@ TEST_CASE("Chip8 Unit Tests")
     }
 }
 
-TEST_CASE("Keyboard Integration Test") {}
+TEST_CASE("State Pool Unit Tests")
+{
+    StatePool pool{4};
+
+    Chip8State *first{ pool.acquire() };
+    REQUIRE(first != nullptr);
+    CHECK_EQ(first->pc, MEM_ADDR_START);
+    CHECK_EQ(first->memory[ADDR_SPRITE + 15], SPRITE_DATA[15]);
+
+    SUBCASE("Recycled states are reset")
+    {
+        first->reg[3] = 0x42;
+        first->memory[MEM_ADDR_START] = 0xAB;
+        CHECK(pool.release(first));
+
+        Chip8State *second{ pool.acquire() };
+        CHECK_EQ(second, first);
+        CHECK_EQ(second->reg[3], 0);
+        CHECK_EQ(second->memory[MEM_ADDR_START], 0);
+    }
+
+    SUBCASE("Double release is refused")
+    {
+        CHECK(pool.release(first));
+        CHECK_FALSE(pool.release(first));
+        CHECK_EQ(pool.size(), 0);
+
+        // Only one owner gets the slot back.
+        Chip8State *second{ pool.acquire() };
+        Chip8State *third{ pool.acquire() };
+        CHECK_NE(second, third);
+
+        Chip8State outside{};
+        CHECK_FALSE(pool.release(&outside));
+        CHECK_EQ(pool.size(), 2);
+    }
+
+    SUBCASE("Reserve covers requested count")
+    {
+        pool.reserve(10);
+        CHECK_GE(pool.capacity(), 10);
+
+        std::vector<Chip8State*> states{};
+        for(std::size_t i{0}; i < 9; ++i) states.push_back(pool.acquire());
+        CHECK_EQ(pool.size(), 10);
+        CHECK_EQ(pool.capacity(), 12);
+    }
+
+    SUBCASE("Chip8 state round trip")
+    {
+        MockBus bus{};
+        bus.cpu.execute(0x6A33);
+
+        Chip8State saved{ bus.cpu.getState() };
+        bus.cpu.execute(0x6A00);
+        bus.cpu.setState(saved);
+        CHECK_MESSAGE(bus.checkRegValue(0xA) == 0x33, "State copy restores registers");
+    }
+}
+
+TEST_CASE("Vectorized Env Unit Tests")
+{
+    // Waits for a key, draws its hex digit at (0, 0), then halts.
+    const uint8_t rom[]{ 0xF1, 0x0A, 0xF1, 0x29, 0xD0, 0x05, 0x12, 0x06 };
+
+    VecEnv env{3, 2, 2, 7};
+    REQUIRE(env.loadProgram(rom, sizeof(rom)));
+
+    uint16_t actions[3]{ 0x0000, 1 << 0x8, (1 << 0xA) | (1 << 0xC) };
+    std::vector<uint8_t> frames(3 * ENV_FRAME_SIZE, 0xFF);
+    uint8_t done[3]{};
+
+    env.step(actions, frames.data(), done);
+
+    CHECK_MESSAGE(done[0] == 0, "Instance without a key keeps waiting on FX0A");
+    CHECK_MESSAGE(done[1] == 1, "Instance halts on a self jump");
+    CHECK(done[2] == 1);
+
+    for(std::size_t x{0}; x < 8; ++x)
+    {
+        CHECK_EQ(frames[x], 0);
+        CHECK_EQ(frames[ENV_FRAME_SIZE + x], (SPRITE_DATA[0x8*5] >> (7 - x)) & 1);
+        CHECK_EQ(frames[2*ENV_FRAME_SIZE + x], (SPRITE_DATA[0xA*5] >> (7 - x)) & 1);
+    }
+    CHECK_EQ(frames[ENV_FRAME_SIZE + 4*WIDTH], SPRITE_DATA[0x8*5 + 4] >> 7);
+
+    CHECK(env.reset(1));
+    CHECK_FALSE(env.reset(env.size()));
+    actions[1] = 0;
+    env.step(actions, frames.data(), done);
+    CHECK_MESSAGE(done[1] == 0, "Reset instance waits again");
+    CHECK_EQ(frames[ENV_FRAME_SIZE], 0);
+
+    // A reset after 00FF starts the next episode in lores, like a new instance.
+    const uint8_t hires_rom[]{ 0x00, 0xFF, 0x12, 0x02 };
+    EnvInstance used{7}, fresh{7};
+    used.reset(hires_rom, sizeof(hires_rom), Profile::SUPER_CHIP);
+    used.advance(0, 1, 0);
+    used.reset(hires_rom, sizeof(hires_rom), Profile::SUPER_CHIP);
+    fresh.reset(hires_rom, sizeof(hires_rom), Profile::SUPER_CHIP);
+    CHECK_EQ(used.hash(), fresh.hash());
+
+    // 00FD only exits where it is an instruction.
+    const uint8_t exit_rom[]{ 0x00, 0xFD, 0x12, 0x00 };
+    EnvInstance schip{7}, chip8{7};
+    schip.reset(exit_rom, sizeof(exit_rom), Profile::SUPER_CHIP);
+    chip8.reset(exit_rom, sizeof(exit_rom), Profile::DEFAULT);
+    schip.advance(0, 1, 0);
+    chip8.advance(0, 1, 0);
+    CHECK(schip.isDone());
+    CHECK_FALSE(chip8.isDone());
+}
+
+TEST_CASE("State Hash Unit Tests")
+{
+    MockBus bus{};
+    const Chip8State& state{ bus.cpu.getState() };
+
+    SUBCASE("Memory hash follows writes")
+    {
+        CHECK_EQ(state.memory_hash, hashMemory(state.memory.data(), MEM_SIZE));
+
+        uint8_t test_data[4]{0xA3, 0x00, 0xF3, 0x55};
+        bus.cpu.loadData(0x200, test_data, 4);
+        CHECK_EQ(state.memory_hash, hashMemory(state.memory.data(), MEM_SIZE));
+
+        bus.cpu.execute(0x60FE);
+        bus.cpu.execute(0xA300);
+        bus.cpu.execute(0xF033);
+        CHECK_MESSAGE(state.memory_hash == hashMemory(state.memory.data(), MEM_SIZE), "FX33 updates hash");
+
+        bus.cpu.execute(0xF555);
+        CHECK_MESSAGE(state.memory_hash == hashMemory(state.memory.data(), MEM_SIZE), "FX55 updates hash");
+    }
+
+    SUBCASE("Addresses wrap at 0xFFF")
+    {
+        // FX55 from 0xFFE stores V0 and V1 at the end, V2 and V3 at the start.
+        bus.cpu.execute(0x60A1);
+        bus.cpu.execute(0x61A2);
+        bus.cpu.execute(0x62A3);
+        bus.cpu.execute(0x63A4);
+        bus.cpu.execute(0xAFFE);
+        bus.cpu.execute(0xF355);
+        CHECK_EQ(state.read(0xFFF), 0xA2);
+        CHECK_EQ(state.read(0x000), 0xA3);
+        CHECK_EQ(state.read(0x1001), 0xA4);
+        CHECK_EQ(state.memory_hash, hashMemory(state.memory.data(), MEM_SIZE));
+
+        // The guard mirrors the start of memory, so spans read across the end.
+        CHECK_EQ(state.span(0xFFE)[3], 0xA4);
+        CHECK_EQ(state.span(0xFFF)[1 + ADDR_SPRITE + 4], SPRITE_DATA[4]);
+
+        // FX65 and DXYN read the same bytes back through the wrap.
+        bus.cpu.execute(0xAFFE);
+        bus.cpu.execute(0xF365);
+        CHECK_EQ(bus.checkRegValue(3), 0xA4);
+
+        bus.cpu.execute(0xAFFF);
+        bus.cpu.execute(0xD002);
+        CHECK_EQ(bus.recentData.draw.data[0], 0xA2);
+        CHECK_EQ(bus.recentData.draw.data[1], 0xA3);
+    }
+
+    SUBCASE("State hash tracks registers")
+    {
+        const uint64_t initial{ bus.cpu.hash() };
+        bus.cpu.execute(0x6301);
+        CHECK_NE(bus.cpu.hash(), initial);
+        bus.cpu.execute(0x6300);
+        bus.cpu.execute(0x1200);
+        CHECK_EQ(bus.cpu.hash(), initial);
+    }
+
+    SUBCASE("Transposition table deduplicates batch states")
+    {
+        const uint8_t rom[]{ 0xF1, 0x0A, 0xF1, 0x29, 0xD0, 0x05, 0x12, 0x06 };
+
+        VecEnv env{4, 1, 2, 3};
+        REQUIRE(env.loadProgram(rom, sizeof(rom)));
+
+        uint16_t actions[4]{ 1 << 0x2, 1 << 0x2, 1 << 0x7, 0x0 };
+        std::vector<uint8_t> frames(4 * ENV_FRAME_SIZE);
+        uint8_t done[4]{};
+        uint8_t novel[4]{};
+
+        TranspositionTable table{64};
+        env.step(actions, frames.data(), done, table, novel);
+
+        CHECK_EQ(env.hash(0), env.hash(1));
+        CHECK_NE(env.hash(0), env.hash(2));
+        CHECK_EQ(novel[0] + novel[1], 1);
+        CHECK_EQ(novel[2], 1);
+        CHECK_EQ(novel[3], 1);
+        CHECK_EQ(table.size(), 3);
+
+        env.step(actions, frames.data(), done, table, novel);
+        CHECK_MESSAGE(novel[0] + novel[1] + novel[2] + novel[3] == 0, "Halted states were seen before");
+    }
+}
+
+TEST_CASE("Debugger Unit Tests")
+{
+    MockBus bus{};
+    Debugger debugger{};
+
+    // 200: V0 = 5, 202: I = 0x300, 204: V0 += 1, 206: store V0, 208: load V0, 20A: loop to 204
+    uint8_t program[12]{0x60, 0x05, 0xA3, 0x00, 0x70, 0x01, 0xF0, 0x55, 0xF0, 0x65, 0x12, 0x04};
+    REQUIRE(bus.cpu.loadData(0x200, program, 12));
+
+    CHECK_FALSE(debugger.armed());
+
+    SUBCASE("Breakpoints stop before the instruction and resume past it")
+    {
+        debugger.setBreakpoint(0x204);
+        REQUIRE(debugger.armed());
+
+        CHECK(debugger.run(bus.cpu, 100) == StopReason::BREAKPOINT);
+        CHECK_EQ(debugger.stopPC(), 0x204);
+        CHECK_EQ(bus.cpu.getState().pc, 0x204);
+        CHECK_MESSAGE(bus.cpu.getState().reg[0] == 0x05, "Stopped before 7XNN ran");
+
+        CHECK(debugger.run(bus.cpu, 100) == StopReason::BREAKPOINT);
+        CHECK_MESSAGE(bus.cpu.getState().reg[0] == 0x06, "Loop ran once after resuming");
+
+        debugger.setBreakpoint(0x204, false);
+        CHECK_FALSE(debugger.armed());
+        CHECK(debugger.run(bus.cpu, 8) == StopReason::NONE);
+    }
+
+    SUBCASE("Watchpoints stop after the access")
+    {
+        debugger.watchWrite(0x300);
+        CHECK(debugger.run(bus.cpu, 100) == StopReason::WATCH_WRITE);
+        CHECK_EQ(debugger.stopPC(), 0x206);
+        CHECK_EQ(debugger.stopAddress(), 0x300);
+        CHECK_EQ(bus.cpu.getState().memory[0x300], 0x06);
+
+        debugger.watchWrite(0x300, 1, false);
+        debugger.watchRead(0x2FF, 2);
+        CHECK(debugger.run(bus.cpu, 100) == StopReason::WATCH_READ);
+        CHECK_EQ(debugger.stopPC(), 0x208);
+    }
+
+    SUBCASE("Register conditions")
+    {
+        debugger.watchRegisterEqual(0, 0x08);
+        CHECK(debugger.run(bus.cpu, 100) == StopReason::REGISTER_EQUAL);
+        CHECK_EQ(debugger.stopAddress(), 0);
+        CHECK_MESSAGE(bus.cpu.getState().reg[0] == 0x08, "Stopped when V0 reached 8");
+
+        debugger.clear();
+        debugger.watchRegister(0xF);
+        CHECK(debugger.run(bus.cpu, 100) == StopReason::NONE);
+    }
+
+    SUBCASE("Debug bursts follow the profile's display wait")
+    {
+        // 200: draw, 202: V1 += 1, 204: loop to 200
+        uint8_t drawing[12]{0xD0, 0x05, 0x71, 0x01, 0x12, 0x00};
+        MockBus plain{};
+        for( MockBus* target : { &bus, &plain } )
+        {
+            REQUIRE(target->cpu.loadData(0x200, drawing, 12));
+            target->cpu.setProfile(Profile::COSMAC_VIP);
+        }
+
+        // Armed, but never hit.
+        debugger.watchWrite(0xFFF);
+        CHECK(debugger.run(bus.cpu, 100) == StopReason::NONE);
+        CHECK_EQ(plain.cpu.cycle(100), 1);
+        CHECK_EQ(bus.cpu.getState().pc, 0x202);
+        CHECK_EQ(bus.cpu.hash(), plain.cpu.hash());
+    }
+}
+
+TEST_CASE("Quirk Profile Unit Tests")
+{
+    MockBus bus{};
+    CHECK(bus.cpu.getProfile() == Profile::DEFAULT);
+
+    bus.cpu.execute(0x6181);
+    bus.cpu.execute(0x6203);
+
+    SUBCASE("Shifts")
+    {
+        bus.cpu.execute(0x8126);
+        CHECK_MESSAGE(bus.checkRegValue(1) == 0x01, "DEFAULT shifts VY into VX");
+
+        bus.cpu.setProfile(Profile::CHIP_48);
+        bus.cpu.execute(0x6181);
+        bus.cpu.execute(0x8126);
+        CHECK_MESSAGE(bus.checkRegValue(1) == 0x40, "CHIP_48 shifts VX in place");
+        CHECK(bus.checkRegValue(15) == 1);
+    }
+
+    SUBCASE("Load and store move index_reg")
+    {
+        uint8_t probe[2]{0xF1, 0x65};
+
+        bus.cpu.setProfile(Profile::COSMAC_VIP);
+        bus.cpu.execute(0xA300);
+        bus.cpu.execute(0xF255);
+        bus.cpu.loadData(0x303, probe, 2);
+        bus.cpu.execute(0xF065);
+        CHECK_MESSAGE(bus.checkRegValue(0) == 0xF1, "COSMAC_VIP leaves I at X + 1");
+
+        bus.cpu.setProfile(Profile::SUPER_CHIP);
+        bus.cpu.execute(0x6000);
+        bus.cpu.execute(0xA300);
+        bus.cpu.execute(0xF255);
+        bus.cpu.execute(0x60AA);
+        bus.cpu.execute(0xF065);
+        CHECK_MESSAGE(bus.checkRegValue(0) == 0x00, "SUPER_CHIP leaves I unchanged");
+    }
+
+    SUBCASE("Jump with offset")
+    {
+        bus.cpu.execute(0x6010);
+        bus.cpu.setProfile(Profile::SUPER_CHIP);
+        bus.cpu.execute(0xB2F0);
+        CHECK_MESSAGE(bus.cpu.getState().pc == 0x2F3, "SUPER_CHIP adds VX");
+
+        bus.cpu.setProfile(Profile::COSMAC_VIP);
+        bus.cpu.execute(0xB2F0);
+        CHECK_MESSAGE(bus.cpu.getState().pc == 0x300, "COSMAC_VIP adds V0");
+    }
+
+    SUBCASE("Logic ops and display wait")
+    {
+        uint8_t program[6]{0x81, 0x21, 0xD0, 0x01, 0x12, 0x00};
+        bus.cpu.loadData(0x200, program, 6);
+        bus.cpu.execute(0x6F01);
+        bus.cpu.execute(0x1200);
+
+        bus.cpu.setProfile(Profile::COSMAC_VIP);
+        CHECK_MESSAGE(bus.cpu.cycle(INSTR_PER_FRAME) == 2, "COSMAC_VIP ends the burst on DXYN");
+        CHECK_MESSAGE(bus.recentData.draw.wrap == false, "COSMAC_VIP clips sprites");
+
+        bus.cpu.execute(0x6F01);
+        bus.cpu.execute(0x8121);
+        CHECK_MESSAGE(bus.checkRegValue(15) == 0, "COSMAC_VIP resets VF on logic ops");
+
+        bus.cpu.setProfile(Profile::DEFAULT);
+        CHECK(bus.cpu.cycle(INSTR_PER_FRAME) == INSTR_PER_FRAME);
+    }
+}
+
+TEST_CASE("Framebuffer Unit Tests")
+{
+    Framebuffer framebuffer{};
+    const uint8_t block[2]{0xFF, 0x81};
+
+    CHECK_FALSE(framebuffer.drawPixelData(2, 3, block, 2));
+    CHECK(framebuffer.pixel(2, 3));
+    CHECK(framebuffer.pixel(9, 3));
+    CHECK_FALSE(framebuffer.pixel(10, 3));
+    CHECK(framebuffer.pixel(2, 4));
+    CHECK_FALSE(framebuffer.pixel(3, 4));
+
+    SUBCASE("Collision and hash")
+    {
+        const uint64_t drawn{ framebuffer.hash() };
+        CHECK_NE(drawn, 0);
+
+        CHECK(framebuffer.drawPixelData(2, 3, block, 2));
+        CHECK_FALSE(framebuffer.pixel(2, 3));
+        CHECK_MESSAGE(framebuffer.hash() == 0, "Drawing twice restores the empty hash");
+
+        framebuffer.drawPixelData(2, 3, block, 2);
+        CHECK_EQ(framebuffer.hash(), drawn);
+        framebuffer.clearScreen();
+        CHECK_EQ(framebuffer.hash(), 0);
+        CHECK_FALSE(framebuffer.pixel(2, 3));
+    }
+
+    SUBCASE("Sprites wrap their origin and clip at the edges")
+    {
+        framebuffer.clearScreen();
+        framebuffer.drawPixelData(WIDTH + 60, HEIGHT + 31, block, 2);
+        CHECK(framebuffer.pixel(60, 31));
+        CHECK(framebuffer.pixel(63, 31));
+        CHECK_FALSE(framebuffer.pixel(0, 31));
+        CHECK_FALSE(framebuffer.pixel(60, 0));
+    }
+
+    SUBCASE("Rendering")
+    {
+        std::vector<uint32_t> argb(WIDTH*HEIGHT);
+        framebuffer.render(argb.data(), 0x10, 0x20);
+        CHECK_EQ(argb[3*WIDTH + 2], 0x20);
+        CHECK_EQ(argb[3*WIDTH + 10], 0x10);
+
+        std::vector<uint8_t> pixels(WIDTH*HEIGHT);
+        framebuffer.render(pixels.data());
+        CHECK_EQ(pixels[4*WIDTH + 9], 1);
+        CHECK_EQ(pixels[4*WIDTH + 8], 0);
+    }
+
+    SUBCASE("Hires mode and wide sprites")
+    {
+        framebuffer.setHires(true);
+        CHECK_EQ(framebuffer.width(), HIRES_WIDTH);
+        CHECK_EQ(framebuffer.height(), HIRES_HEIGHT);
+        CHECK_FALSE(framebuffer.pixel(2, 3));
+        CHECK_MESSAGE(framebuffer.hash() != 0, "The mode is part of the hash");
+
+        const uint8_t wide[4]{0xFF, 0xFF, 0x80, 0x01};
+        framebuffer.drawPixelData(120, 62, wide, 2, false, true);
+        CHECK(framebuffer.pixel(127, 62));
+        CHECK(framebuffer.pixel(120, 63));
+        CHECK_FALSE(framebuffer.pixel(127, 63));
+        CHECK_FALSE(framebuffer.pixel(0, 62));
+
+        framebuffer.clearScreen();
+        framebuffer.drawPixelData(120, 62, wide, 2, true, true);
+        CHECK(framebuffer.pixel(7, 62));
+        CHECK(framebuffer.pixel(7, 63));
+        CHECK_FALSE(framebuffer.pixel(6, 63));
+
+        std::vector<uint8_t> pixels(WIDTH*HEIGHT);
+        framebuffer.renderLores(pixels.data());
+        CHECK_EQ(pixels[31*WIDTH + 3], 1);
+        CHECK_EQ(pixels[31*WIDTH + 60], 1);
+        CHECK_EQ(pixels[31*WIDTH + 4], 0);
+
+        framebuffer.setHires(false);
+        CHECK_EQ(framebuffer.hash(), 0);
+    }
+
+    SUBCASE("Scrolling")
+    {
+        const uint64_t drawn{ framebuffer.hash() };
+
+        framebuffer.scroll(4, 0);
+        CHECK_FALSE(framebuffer.pixel(2, 3));
+        CHECK(framebuffer.pixel(6, 3));
+        CHECK(framebuffer.pixel(13, 4));
+
+        framebuffer.scroll(-4, 2);
+        CHECK(framebuffer.pixel(2, 5));
+        CHECK_FALSE(framebuffer.pixel(2, 3));
+
+        framebuffer.scroll(0, -2);
+        CHECK_EQ(framebuffer.hash(), drawn);
+
+        framebuffer.setHires(true);
+        framebuffer.drawPixelData(60, 0, block, 1);
+        framebuffer.scroll(4, 0);
+        CHECK(framebuffer.pixel(64, 0));
+        CHECK(framebuffer.pixel(71, 0));
+        framebuffer.scroll(-8, 0);
+        CHECK(framebuffer.pixel(56, 0));
+        CHECK(framebuffer.pixel(63, 0));
+        CHECK_FALSE(framebuffer.pixel(64, 0));
+    }
+
+    SUBCASE("Bitplanes")
+    {
+        framebuffer.clearScreen();
+
+        const uint8_t planes[2]{0xF0, 0x3C};
+        CHECK_FALSE(framebuffer.drawPixelData(0, 0, planes, 1, false, false, 0x3));
+        CHECK_EQ(framebuffer.pixel(0, 0), 1);
+        CHECK_EQ(framebuffer.pixel(2, 0), 3);
+        CHECK_EQ(framebuffer.pixel(5, 0), 2);
+        CHECK_EQ(framebuffer.pixel(6, 0), 0);
+
+        framebuffer.scroll(0, 1, 0x2);
+        CHECK_EQ(framebuffer.pixel(2, 0), 1);
+        CHECK_EQ(framebuffer.pixel(2, 1), 2);
+
+        framebuffer.clearScreen(0x1);
+        CHECK_EQ(framebuffer.pixel(0, 0), 0);
+        CHECK_EQ(framebuffer.pixel(5, 1), 2);
+
+        // The partial clear updated the hash in place; a full rehash agrees.
+        Framebuffer rehashed{};
+        rehashed.setHires(framebuffer.isHires());
+        for( std::size_t p{0}; p < PLANES; ++p ) rehashed.setPlane(p, framebuffer.getPlane(p));
+        CHECK_EQ(framebuffer.hash(), rehashed.hash());
+
+        std::vector<uint32_t> argb(WIDTH*HEIGHT);
+        framebuffer.render(argb.data(), {0x10, 0x20, 0x30, 0x40});
+        CHECK_EQ(argb[WIDTH + 5], 0x30);
+    }
+
+    SUBCASE("Deferred draws")
+    {
+        const uint8_t block[2]{0xFF, 0x81};
+        framebuffer.drawPixelData(4, 6, block, 2);
+
+        DrawList draws{};
+        draws.reset(framebuffer);
+        const Framebuffer before{framebuffer};
+
+        // Collisions come from the shadow while the framebuffer is untouched.
+        Random random{5};
+        Framebuffer direct{framebuffer};
+        for( std::size_t i{0}; i < 200; ++i )
+        {
+            uint8_t sprite[8]{};
+            for( uint8_t& byte : sprite ) byte = random.next();
+            const uint16_t x{ static_cast<uint16_t>(random.next() % 128) };
+            const uint16_t y{ static_cast<uint16_t>(random.next() % 64) };
+            const uint8_t planes{ static_cast<uint8_t>(1 + i % 3) };
+
+            if( i == 60 || i == 150 )
+            {
+                draws.setHires(i == 60);
+                direct.setHires(i == 60);
+            }
+            else if( i % 37 == 0 )
+            {
+                draws.clearScreen(planes);
+                direct.clearScreen(planes);
+            }
+            else if( i % 23 == 0 )
+            {
+                draws.scroll(4, -2, planes);
+                direct.scroll(4, -2, planes);
+            }
+            CHECK_EQ(draws.drawPixelData(x, y, sprite, 2, i % 2 == 0, false, planes),
+                direct.drawPixelData(x, y, sprite, 2, i % 2 == 0, false, planes));
+            sprite[0] = ~sprite[0];
+        }
+        CHECK_EQ(framebuffer.hash(), before.hash());
+        CHECK_EQ(draws.getShadow().hash(), direct.hash());
+
+        // Replaying the commands and presenting the shadow agree.
+        Framebuffer replayed{before};
+        draws.replay(replayed);
+        CHECK_EQ(replayed.hash(), direct.hash());
+
+        draws.present(framebuffer);
+        CHECK(draws.getCommands().empty());
+        CHECK_EQ(framebuffer.isHires(), direct.isHires());
+        CHECK_EQ(framebuffer.hash(), direct.hash());
+        for( std::size_t p{0}; p < PLANES; ++p ) CHECK(framebuffer.getPlane(p) == direct.getPlane(p));
+    }
+}
+
+TEST_CASE("Extended Opcode Unit Tests")
+{
+    MockBus bus{};
+
+    SUBCASE("CHIP-8 profiles ignore them")
+    {
+        bus.cpu.execute(0x00FF);
+        CHECK(bus.recentData.type != EventType::DISPLAY_MODE);
+        CHECK_MESSAGE(bus.cpu.getState().memory[ADDR_BIG_SPRITE] == 0, "No big font without SUPER-CHIP opcodes");
+    }
+
+    bus.cpu.setProfile(Profile::SUPER_CHIP);
+
+    SUBCASE("Display control")
+    {
+        bus.cpu.execute(0x00FF);
+        REQUIRE(bus.recentData.type == EventType::DISPLAY_MODE);
+        CHECK(bus.recentData.hires);
+
+        bus.cpu.execute(0x00C5);
+        REQUIRE(bus.recentData.type == EventType::DISPLAY_SCROLL);
+        CHECK_EQ(bus.recentData.scroll.dy, 5);
+        CHECK_EQ(bus.recentData.scroll.planes, 1);
+
+        bus.cpu.execute(0x00FC);
+        CHECK_EQ(bus.recentData.scroll.dx, -4);
+
+        bus.cpu.execute(0xD120);
+        CHECK(bus.recentData.draw.wide);
+        CHECK_EQ(bus.recentData.draw.size, 16);
+    }
+
+    SUBCASE("Big font and flags")
+    {
+        bus.cpu.execute(0x6009);
+        bus.cpu.execute(0xF030);
+        CHECK_EQ(bus.cpu.getState().index_reg, ADDR_BIG_SPRITE + 90);
+
+        const uint8_t big_font[BIG_HEX_SPRITE_LENGTH]{BIG_HEX_SPRITE_DATA};
+        CHECK_EQ(bus.cpu.getState().memory[ADDR_BIG_SPRITE + 90], big_font[90]);
+
+        // Back to CHIP-8, the font goes and the memory hash follows.
+        bus.cpu.setProfile(Profile::DEFAULT);
+        CHECK_EQ(bus.cpu.getState().memory[ADDR_BIG_SPRITE + 90], 0);
+        CHECK_EQ(bus.cpu.getState().memory_hash, hashMemory(bus.cpu.getState().memory.data(), MEM_SIZE));
+        bus.cpu.setProfile(Profile::SUPER_CHIP);
+
+        bus.cpu.execute(0x6142);
+        bus.cpu.execute(0xF175);
+        bus.cpu.execute(0x6100);
+        bus.cpu.execute(0xF185);
+        CHECK_EQ(bus.checkRegValue(1), 0x42);
+
+        const uint8_t exit[2]{0x00, 0xFD};
+        bus.cpu.loadData(MEM_ADDR_START, exit, 2);
+        bus.cpu.execute(0x1200);
+        bus.cpu.cycle(INSTR_PER_FRAME);
+        CHECK_EQ(bus.cpu.getState().pc, MEM_ADDR_START);
+    }
+
+    SUBCASE("XO-CHIP planes")
+    {
+        bus.cpu.execute(0xF301);
+        CHECK_EQ(bus.cpu.getState().planes, 1);
+
+        bus.cpu.setProfile(Profile::XO_CHIP);
+        bus.cpu.execute(0xF301);
+        bus.cpu.execute(0x00E0);
+        CHECK_EQ(bus.recentData.planes, 3);
+
+        bus.cpu.execute(0x00D2);
+        CHECK_EQ(bus.recentData.scroll.dy, -2);
+    }
+}
+
+TEST_CASE("Capture Unit Tests")
+{
+    const std::filesystem::path path{ std::filesystem::temp_directory_path() / "chip8_capture_test.y4m" };
+    const uint8_t block[2]{0xFF, 0x81};
+
+    Framebuffer framebuffer{};
+    framebuffer.drawPixelData(0, 0, block, 2);
+
+    {
+        Capture capture{path.string(), 2, {0x00000000, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF}, 2};
+        REQUIRE(capture.isOpen());
+
+        std::size_t accepted{0};
+        for( std::size_t i{0}; i < 3; ++i ) accepted += capture.submit(framebuffer);
+        capture.close();
+
+        const CaptureStats stats{ capture.stats() };
+        CHECK_EQ(stats.submitted, 3);
+        CHECK_EQ(stats.written, accepted);
+        CHECK_EQ(stats.written + stats.dropped, 3);
+        CHECK_EQ(stats.queue_depth, 0);
+        CHECK_FALSE(capture.submit(framebuffer));
+    }
+
+    std::ifstream is{path, std::ios_base::in | std::ios_base::binary};
+    std::string header{};
+    std::getline(is, header);
+    CHECK_EQ(header, "YUV4MPEG2 W256 H128 F60:1 Ip A1:1 Cmono");
+
+    std::string frame{};
+    std::getline(is, frame);
+    CHECK_EQ(frame, "FRAME");
+
+    // Lores pixels are doubled to hires and then scaled by 2.
+    std::vector<char> rows(256*5);
+    is.read(rows.data(), static_cast<std::streamsize>(rows.size()));
+    CHECK_EQ(static_cast<uint8_t>(rows[0]), 0xFF);
+    CHECK_EQ(static_cast<uint8_t>(rows[31]), 0xFF);
+    CHECK_EQ(static_cast<uint8_t>(rows[32]), 0x00);
+    CHECK_EQ(static_cast<uint8_t>(rows[256*4 + 4]), 0x00);
+    CHECK_EQ(static_cast<uint8_t>(rows[256*4 + 3]), 0xFF);
+
+    is.close();
+    std::filesystem::remove(path);
+}
+
+// Flips VE after every 7XNN, a bug the fuzzer must find and shrink.
+void stepBroken(Chip8& cpu)
+{
+    const uint16_t opcode{ cpu.fetch() };
+    cpu.execute(opcode);
+
+    if( (opcode & 0xF000) != 0x7000 ) return;
+
+    Chip8State state{ cpu.getState() };
+    state.reg[0xE] ^= 1;
+    cpu.setState(state);
+}
+
+TEST_CASE("Differential Fuzzer")
+{
+    FuzzOptions options{};
+    options.max_cases = 200;
+    options.threads = 2;
+    options.seed = 7;
+
+    SUBCASE("Backends match the reference")
+    {
+        for( Backend backend : { stepCycle, stepDebugger } )
+        {
+            options.candidate = backend;
+            const FuzzResult result{ fuzz(options) };
+            CHECK_EQ(result.cases, 200);
+            CHECK(result.instructions > 0);
+            CHECK_FALSE(result.divergence.found);
+        }
+    }
+
+    SUBCASE("Divergences are minimized")
+    {
+        options.candidate = stepBroken;
+        const FuzzResult result{ fuzz(options) };
+        REQUIRE(result.divergence.found);
+        CHECK_EQ(result.divergence.field, "reg[14]");
+
+        // Only the 7XNN needs to survive.
+        const FuzzCase& test{ result.reproducer };
+        std::size_t instructions{0};
+        for( std::size_t i{0}; i + 1 < test.program.size(); i += 2 ) instructions += (test.program[i] | test.program[i + 1]) != 0;
+        CHECK_EQ(instructions, 1);
+        CHECK(runLockstep(test, stepBroken).found);
+        CHECK_FALSE(runLockstep(test, stepCycle).found);
+    }
+}
+
+TEST_CASE("Latency Probe Unit Tests")
+{
+    using std::chrono::microseconds;
+
+    LatencyProbe probe{};
+    const LatencyClock::time_point t{};
+
+    // Stages only advance in order, later events of an idle probe are ignored.
+    probe.drawn(t);
+    probe.presented(t);
+    CHECK_EQ(probe.stage(LatencyStage::TOTAL).count(), 0);
+
+    probe.keyPressed(t, t + microseconds(100));
+    probe.drawn(t + microseconds(150));
+    probe.keyObserved(t + microseconds(300));
+    probe.keyObserved(t + microseconds(350));
+    probe.drawn(t + microseconds(1300));
+    probe.presented(t + microseconds(5300));
+
+    CHECK_EQ(probe.stage(LatencyStage::QUEUE).percentile(0.5), 100);
+    CHECK_EQ(probe.stage(LatencyStage::OBSERVE).percentile(0.5), 200);
+    CHECK_EQ(probe.stage(LatencyStage::DRAW).percentile(0.5), 1000);
+    CHECK_EQ(probe.stage(LatencyStage::PRESENT).percentile(0.5), 4000);
+    CHECK_EQ(probe.stage(LatencyStage::TOTAL).percentile(0.5), 5300);
+    CHECK_EQ(probe.stage(LatencyStage::TOTAL).buckets()[12], 1);
+    CHECK_EQ(probe.abandonedCount(), 0);
+
+    // A press the ROM never reads is abandoned by the next one.
+    probe.keyPressed(t, t);
+    probe.keyPressed(t, t);
+    CHECK_EQ(probe.abandonedCount(), 2);
+    CHECK_EQ(probe.stage(LatencyStage::QUEUE).count(), 3);
+}
+
+TEST_CASE("Run-Ahead Unit Tests")
+{
+    const FuzzCase test{ .program = { 0x60, 0x00, 0xC1, 0x3F, 0xF1, 0x18, 0xF0, 0x29, 0xD0, 0x05, 0x70, 0x01, 0x12, 0x02 },
+        .seed = 0x10, .profile = Profile::DEFAULT };
+
+    FuzzBus real{test};
+    FuzzBus reference{test};
+    RunAhead runahead{real.cpu, real.framebuffer, real.random, 2};
+
+    // Two frames ahead of the reference, which never runs ahead.
+    for( std::size_t i{0}; i < 2; ++i )
+    {
+        reference.cpu.cycle(INSTR_PER_FRAME);
+        reference.cpu.tickTimer();
+    }
+
+    for( std::size_t frame{0}; frame < 30; ++frame )
+    {
+        const uint64_t shown{ runahead.step().hash() };
+
+        reference.cpu.cycle(INSTR_PER_FRAME);
+        reference.cpu.tickTimer();
+        CHECK_EQ(shown, reference.framebuffer.hash());
+    }
+
+    // Restoring leaves the real machine exactly where it was.
+    FuzzBus plain{test};
+    for( std::size_t frame{0}; frame < 30; ++frame )
+    {
+        plain.cpu.cycle(INSTR_PER_FRAME);
+        plain.cpu.tickTimer();
+    }
+    CHECK_EQ(real.cpu.hash(), plain.cpu.hash());
+    CHECK_EQ(real.framebuffer.hash(), plain.framebuffer.hash());
+    CHECK_EQ(runahead.getStats().frames, 30);
+}
+
+// Counts the frames each session delivered.
+void countFrame(void *context, std::size_t session, const Framebuffer&)
+{
+    static_cast<std::atomic<uint64_t>*>(context)[session].fetch_add(1);
+}
+
+TEST_CASE("Session Host Unit Tests")
+{
+    // Waits for a key and draws its digit, then loops forever.
+    const uint8_t key_rom[8]{ 0xF0, 0x0A, 0xF0, 0x29, 0xD0, 0x05, 0x12, 0x06 };
+    const uint8_t loop_rom[2]{ 0x12, 0x00 };
+
+    std::atomic<uint64_t> delivered[2]{};
+    SessionHost host{1, countFrame, delivered};
+    host.addSession(key_rom, 8, Profile::DEFAULT, 1);
+    host.addSession(loop_rom, 2, Profile::DEFAULT, 2);
+
+    host.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    // The waiting session parks after its first frame, the other keeps going.
+    CHECK_EQ(delivered[0].load(), 1);
+    CHECK_GE(delivered[1].load(), 3);
+
+    host.setKeys(0, 1 << 5);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    host.stop();
+
+    CHECK_GE(delivered[0].load(), 3);
+    CHECK_EQ(host.sessionStats(0).frames, delivered[0].load());
+    CHECK_GE(host.sessionStats(0).parked_frames, 3);
+
+    const HostStats stats{ host.stats() };
+    CHECK_EQ(stats.sessions, 2);
+    CHECK_EQ(stats.frames, delivered[0].load() + delivered[1].load());
+    CHECK_GT(stats.latency.percentileUs(1), 0);
+}
+
+TEST_CASE("Static Analyzer Unit Tests")
+{
+    SUBCASE("Code, sprites and writes")
+    {
+        // Draws a sprite, jumps through BNNN with V0 known, then calls a
+        // subroutine that stores BCD over its own RET.
+        const uint8_t rom[45]{
+            0xA2, 0x28, 0xD0, 0x15, 0x60, 0x02, 0xB2, 0x0A, 0x12, 0x08, 0x12, 0x0A, 0x22, 0x12, 0x12, 0x00,
+            0x00, 0x00, 0xA2, 0x16, 0xF0, 0x33, 0x00, 0xEE, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF0, 0x90, 0x90, 0x90, 0xF0
+        };
+        const ProgramAnalysis analysis{ analyzeProgram(rom, 45, Profile::DEFAULT) };
+
+        CHECK_EQ(analysis.instructions.size(), 9);
+        CHECK_EQ(analysis.blocks.size(), 4);
+        CHECK_EQ(analysis.kinds[0x200], ByteKind::CODE);
+        CHECK_EQ(analysis.kinds[0x208], ByteKind::UNKNOWN);
+        CHECK_EQ(analysis.kinds[0x20A], ByteKind::UNKNOWN);
+        CHECK_EQ(analysis.kinds[0x22C], ByteKind::SPRITE);
+        CHECK_EQ(toRanges(analysis.kinds, ByteKind::SPRITE).size(), 1);
+
+        REQUIRE_EQ(analysis.indirect_jumps.size(), 1);
+        CHECK_EQ(analysis.indirect_jumps[0].addr, 0x206);
+        CHECK((analysis.indirect_jumps[0].targets == std::vector<uint16_t>{ 0x20C }));
+
+        const CfgBlock* call{ analysis.blockAt(0x20C) };
+        REQUIRE(call != nullptr);
+        REQUIRE_EQ(call->successors.size(), 2);
+        CHECK_EQ(call->successors[0].kind, EdgeKind::CALL);
+        CHECK_EQ(call->successors[1].kind, EdgeKind::RETURN_SITE);
+
+        CHECK_EQ(analysis.write_targets.count(), 3);
+        CHECK_EQ(analysis.unresolved_writes, 0);
+        REQUIRE_EQ(analysis.self_modifying.size(), 1);
+        CHECK_EQ(analysis.self_modifying[0].start, 0x216);
+        CHECK_EQ(analysis.self_modifying[0].end, 0x218);
+
+        REQUIRE_EQ(analysis.loops.size(), 1);
+        CHECK_EQ(analysis.loops[0].head, 0x200);
+        CHECK_EQ(analysis.loops[0].tail, 0x20E);
+        CHECK_EQ(analysis.loops[0].flags, LOOP_DRAWS | LOOP_CALLS | LOOP_HOT);
+
+        std::ostringstream dot{}, json{};
+        writeDot(analysis, dot);
+        writeJson(analysis, json);
+        CHECK_NE(dot.str().find("b200 -> b20c [label=\"indirect\"]"), std::string::npos);
+        CHECK_NE(dot.str().find("0x202  DRW V0, V1, 5"), std::string::npos);
+        CHECK_NE(json.str().find("\"self_modifying\": [[534, 536]]"), std::string::npos);
+    }
+
+    SUBCASE("Stores through an unknown I")
+    {
+        // The loop adds a random V1 to I and stores V0 there, which may
+        // overwrite the loop itself.
+        const uint8_t rom[12]{ 0x60, 0x00, 0xA3, 0x00, 0xC1, 0xFF, 0xF1, 0x1E, 0xF0, 0x55, 0x12, 0x04 };
+        const ProgramAnalysis analysis{ analyzeProgram(rom, 12, Profile::DEFAULT) };
+
+        CHECK_EQ(analysis.unresolved_writes, 1);
+        REQUIRE_EQ(analysis.self_modifying.size(), 1);
+        CHECK_EQ(analysis.self_modifying[0].start, 0x200);
+        CHECK_EQ(analysis.self_modifying[0].end, 0x20C);
+
+        REQUIRE_EQ(analysis.loops.size(), 1);
+        CHECK_EQ(analysis.loops[0].head, 0x204);
+        CHECK_EQ(analysis.loops[0].flags, LOOP_SELF_MODIFYING);
+    }
+
+    SUBCASE("Stores wrap past 0xFFF")
+    {
+        // I = 0xF0D + 3 * 0xFF = 0x120A, which the interpreter masks to the
+        // FX55 at 0x20A, so the loop rewrites itself.
+        const uint8_t rom[14]{ 0xAF, 0x0D, 0x61, 0xFF, 0xF1, 0x1E, 0xF1, 0x1E, 0xF1, 0x1E, 0xF0, 0x55, 0x12, 0x0A };
+        const ProgramAnalysis analysis{ analyzeProgram(rom, 14, Profile::DEFAULT) };
+
+        CHECK_EQ(analysis.unresolved_writes, 0);
+        CHECK(analysis.write_targets[0x20A]);
+        REQUIRE_EQ(analysis.self_modifying.size(), 1);
+        CHECK_EQ(analysis.self_modifying[0].start, 0x20A);
+        CHECK_EQ(analysis.self_modifying[0].end, 0x20B);
+
+        REQUIRE_EQ(analysis.loops.size(), 1);
+        CHECK_EQ(analysis.loops[0].head, 0x20A);
+        CHECK_EQ(analysis.loops[0].flags, LOOP_SELF_MODIFYING);
+    }
+
+    SUBCASE("Jump tables")
+    {
+        // V0 is random, so BNNN may take any jump of the table at 0x206.
+        const uint8_t rom[14]{ 0xC0, 0x03, 0xB2, 0x06, 0x00, 0x00, 0x12, 0x0A, 0x12, 0x0C, 0x00, 0xE0, 0x12, 0x0C };
+        const ProgramAnalysis analysis{ analyzeProgram(rom, 14, Profile::DEFAULT) };
+
+        REQUIRE_EQ(analysis.indirect_jumps.size(), 1);
+        CHECK((analysis.indirect_jumps[0].targets == std::vector<uint16_t>{ 0x206, 0x208 }));
+        CHECK_EQ(analysis.kinds[0x204], ByteKind::UNKNOWN);
+        CHECK_EQ(analysis.kinds[0x20A], ByteKind::CODE);
+
+        REQUIRE_EQ(analysis.loops.size(), 1);
+        CHECK_EQ(analysis.loops[0].flags, LOOP_HALTS);
+    }
+
+    SUBCASE("Disassembly")
+    {
+        CHECK_EQ(disassemble(0xD015), "DRW V0, V1, 5");
+        CHECK_EQ(disassemble(0xF255), "LD [I], V2");
+        CHECK_EQ(disassemble(0xB20A), "JP V0, 0x20A");
+        CHECK_EQ(disassemble(0xB20A, Profile::CHIP_48), "JP V2, 0x20A");
+        CHECK_EQ(disassemble(0x8AB8), "DW 0x8AB8");
+    }
+}
+
+TEST_CASE("ROM Library Unit Tests")
+{
+    // Switches to hires, spins on the delay timer, draws and halts.
+    const uint8_t schip_rom[12]{ 0x00, 0xFF, 0xF0, 0x07, 0x30, 0x00, 0x12, 0x02, 0xD0, 0x15, 0x12, 0x0A };
+
+    SUBCASE("Analysis")
+    {
+        const RomAnalysis analysis{ analyzeRom(schip_rom, 12) };
+        CHECK_EQ(analysis.profile, Profile::SUPER_CHIP);
+
+        const std::vector<std::pair<uint16_t, uint16_t>> blocks{ {0x200, 0x202}, {0x202, 0x206}, {0x206, 0x208},
+            {0x208, 0x20A}, {0x20A, 0x20C} };
+        REQUIRE_EQ(analysis.blocks.size(), blocks.size());
+        for( std::size_t i{0}; i < blocks.size(); ++i )
+        {
+            CHECK_EQ(analysis.blocks[i].start, blocks[i].first);
+            CHECK_EQ(analysis.blocks[i].end, blocks[i].second);
+        }
+
+        REQUIRE_EQ(analysis.loops.size(), 2);
+        CHECK_EQ(analysis.loops[0].head, 0x202);
+        CHECK_EQ(analysis.loops[0].tail, 0x206);
+        CHECK_EQ(analysis.loops[0].flags, LOOP_POLLS_TIMER | LOOP_HOT);
+        CHECK_EQ(analysis.loops[1].head, 0x20A);
+        CHECK_EQ(analysis.loops[1].flags, LOOP_HALTS);
+
+        const uint8_t xochip_rom[4]{ 0xF1, 0x01, 0x12, 0x02 };
+        const RomAnalysis xochip{ analyzeRom(xochip_rom, 4) };
+        CHECK_EQ(xochip.profile, Profile::XO_CHIP);
+        CHECK_EQ(xochip.blocks.size(), 2);
+    }
+
+    SUBCASE("Cache by content")
+    {
+        const std::filesystem::path directory{ std::filesystem::temp_directory_path() / "chip8_rom_test" };
+        const std::filesystem::path cache{ directory / "analysis.cache" };
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory / "copies");
+
+        for( const std::filesystem::path& path : { directory / "a.ch8", directory / "copies" / "b.ch8", directory / "c.txt" } )
+        {
+            std::ofstream os{path, std::ios_base::out | std::ios_base::binary};
+            os.write(reinterpret_cast<const char*>(schip_rom), 12);
+        }
+
+        {
+            RomLibrary library{cache.string()};
+            REQUIRE_EQ(library.scan(directory.string()), 2);
+            CHECK_EQ(library.image(0).hash(), library.image(1).hash());
+            CHECK_EQ(library.image(0).hash(), romHash(schip_rom, 12));
+            CHECK_EQ(library.image(0).size(), 12);
+
+            // The copy under another name is the same ROM.
+            CHECK_EQ(library.analysis(library.image(0)).profile, Profile::SUPER_CHIP);
+            CHECK_EQ(library.analysis(library.image(1)).loops.size(), 2);
+            CHECK_EQ(library.stats().analysed, 1);
+            CHECK_EQ(library.stats().memory_hits, 1);
+            CHECK(library.save());
+        }
+
+        RomLibrary library{cache.string()};
+        const RomAnalysis& analysis{ library.analysis(schip_rom, 12) };
+        CHECK_EQ(library.stats().disk_hits, 1);
+        CHECK_EQ(library.stats().analysed, 0);
+        CHECK_EQ(analysis.blocks.size(), 5);
+        CHECK_EQ(analysis.loops[0].flags, LOOP_POLLS_TIMER | LOOP_HOT);
+
+        std::filesystem::remove_all(directory);
+    }
+}
+
+#ifdef CHIP8_SAVESTATE
+TEST_CASE("Savestate Store Unit Tests")
+{
+    const FuzzCase test{ .program = { 0x60, 0x00, 0xC1, 0x3F, 0xF1, 0x18, 0xF0, 0x29, 0xD0, 0x05, 0x70, 0x01, 0x12, 0x02 },
+        .seed = 0x10, .profile = Profile::DEFAULT };
+    const std::filesystem::path path{ std::filesystem::temp_directory_path() / "chip8_savestate_test.pack" };
+    std::filesystem::remove(path);
+
+    FuzzBus bus{test};
+    std::vector<Snapshot> saved{};
+    {
+        // A group of 4 syncs twice over 10 checkpoints, the rest on close.
+        SaveStore store{path.string(), 4};
+        REQUIRE(store.isOpen());
+
+        for( std::size_t frame{0}; frame < 10; ++frame )
+        {
+            bus.cpu.cycle(INSTR_PER_FRAME);
+            bus.cpu.tickTimer();
+
+            Snapshot snapshot{ bus.cpu.getState(), bus.framebuffer, bus.random };
+            CHECK_EQ(store.put(snapshot), frame);
+            saved.push_back(snapshot);
+        }
+
+        // Unwritten checkpoints read back from the buffer.
+        Snapshot loaded{};
+        REQUIRE(store.get(9, loaded));
+        CHECK_EQ(loaded.cpu.hash(), saved[9].cpu.hash());
+
+        const SaveStoreStats stats{ store.stats() };
+        CHECK_EQ(stats.checkpoints, 10);
+        CHECK_EQ(stats.chunk_refs, 10 * SAVE_CHUNKS);
+        CHECK_EQ(stats.syncs, 2);
+        CHECK_LT(stats.chunks, stats.chunk_refs / 4);
+        CHECK_LT(stats.pack_bytes, 10 * SAVE_IMAGE_SIZE / 4);
+    }
+
+    SUBCASE("Reopen")
+    {
+        SaveStore store{path.string()};
+        REQUIRE(store.isOpen());
+        REQUIRE_EQ(store.size(), saved.size());
+
+        for( std::size_t i{0}; i < saved.size(); ++i )
+        {
+            Snapshot loaded{};
+            REQUIRE(store.get(i, loaded));
+            CHECK_EQ(loaded.cpu.hash(), saved[i].cpu.hash());
+            CHECK_EQ(loaded.cpu.memory_hash, saved[i].cpu.memory_hash);
+            CHECK_EQ(loaded.framebuffer.hash(), saved[i].framebuffer.hash());
+            CHECK_EQ(loaded.random.next64(), saved[i].random.next64());
+        }
+
+        Snapshot missing{};
+        CHECK_FALSE(store.get(saved.size(), missing));
+    }
+
+    SUBCASE("Truncated tail")
+    {
+        std::filesystem::resize_file(path, std::filesystem::file_size(path) - 3);
+
+        SaveStore store{path.string()};
+        REQUIRE(store.isOpen());
+        CHECK_EQ(store.size(), saved.size() - 1);
+
+        // Appends go after the last whole record.
+        CHECK_EQ(store.put(saved.back()), saved.size() - 1);
+        REQUIRE(store.flush());
+
+        SaveStore reopened{path.string()};
+        Snapshot loaded{};
+        REQUIRE(reopened.get(saved.size() - 1, loaded));
+        CHECK_EQ(loaded.cpu.hash(), saved.back().cpu.hash());
+    }
+
+    SUBCASE("Not a pack")
+    {
+        std::ofstream{ path, std::ios::binary | std::ios::trunc } << "not a savestate pack";
+        SaveStore store{path.string()};
+        CHECK_FALSE(store.isOpen());
+    }
+
+    std::filesystem::remove(path);
+}
+#endif
+
+#ifdef CHIP8_STREAM
+Planes planesOf(const Framebuffer& framebuffer)
+{
+    Planes planes{};
+    for( std::size_t p{0}; p < PLANES; ++p ) planes[p] = framebuffer.getPlane(p);
+    return planes;
+}
+
+// Applies an encoded message the way a client reads it, without the size field.
+bool applyMessage(RowDeltaDecoder& decoder, const std::array<uint8_t, STREAM_HEADER_SIZE>& header,
+    const std::vector<uint8_t>& payload)
+{
+    std::vector<uint8_t> message{ header.begin() + 4, header.end() };
+    message.insert(message.end(), payload.begin(), payload.end());
+    return decoder.apply(message.data(), message.size());
+}
+
+bool sameFrame(const Framebuffer& framebuffer, const RowDeltaDecoder& decoder)
+{
+    if( framebuffer.isHires() != decoder.isHires() ) return false;
+    for( std::size_t y{0}; y < framebuffer.height(); ++y )
+    {
+        for( std::size_t x{0}; x < framebuffer.width(); ++x )
+        {
+            if( framebuffer.pixel(x, y) != decoder.pixel(x, y) ) return false;
+        }
+    }
+    return true;
+}
+
+TEST_CASE("Stream Unit Tests")
+{
+    SUBCASE("PackBits round trip")
+    {
+        std::vector<uint8_t> data(300, 0xAA);
+        for( std::size_t i{140}; i < 160; ++i ) data[i] = static_cast<uint8_t>(i);
+        data[299] = 0x01;
+
+        std::vector<uint8_t> packed{};
+        packBits(data.data(), data.size(), packed);
+        CHECK_LT(packed.size(), 40);
+
+        std::vector<uint8_t> unpacked(data.size());
+        CHECK_EQ(unpackBits(packed.data(), packed.size(), unpacked.data(), unpacked.size()), packed.size());
+        CHECK(unpacked == data);
+
+        // Truncated input is rejected rather than read past.
+        CHECK_EQ(unpackBits(packed.data(), packed.size() - 1, unpacked.data(), unpacked.size()), 0);
+    }
+
+    SUBCASE("Decoded frames match the framebuffer")
+    {
+        Framebuffer framebuffer{};
+        Random random{3};
+        RowDeltaEncoder encoder{};
+        RowDeltaDecoder decoder{};
+        std::array<uint8_t, STREAM_HEADER_SIZE> header{};
+        std::vector<uint8_t> payload{};
+
+        for( uint32_t frame{1}; frame <= 40; ++frame )
+        {
+            if( frame == 20 ) framebuffer.setHires(true);
+
+            const uint8_t sprite[4]{ static_cast<uint8_t>(random.next()), static_cast<uint8_t>(random.next()),
+                static_cast<uint8_t>(random.next()), static_cast<uint8_t>(random.next()) };
+            framebuffer.drawPixelData(static_cast<uint16_t>(random.next() % 128), static_cast<uint16_t>(random.next() % 64),
+                sprite, 2, false, false, static_cast<uint8_t>(1 + frame % 3));
+
+            REQUIRE(encoder.encode(planesOf(framebuffer), framebuffer.isHires(), frame, header, payload));
+            REQUIRE(applyMessage(decoder, header, payload));
+            CHECK(sameFrame(framebuffer, decoder));
+            CHECK_EQ(decoder.getSequence(), frame);
+
+            // Only the first frame and the mode switch resend every row.
+            CHECK_EQ((header[4] & STREAM_FLAG_KEYFRAME) != 0, frame == 1 || frame == 20);
+        }
+
+        // Nothing changed, nothing to send.
+        CHECK_FALSE(encoder.encode(planesOf(framebuffer), framebuffer.isHires(), 41, header, payload));
+
+        encoder.reset();
+        REQUIRE(encoder.encode(planesOf(framebuffer), framebuffer.isHires(), 42, header, payload));
+        CHECK_NE(header[4] & STREAM_FLAG_KEYFRAME, 0);
+    }
+
+    SUBCASE("A viewer receives the latest frame over a socket")
+    {
+        const std::filesystem::path path{ std::filesystem::temp_directory_path() / "chip8_stream_test.sock" };
+        std::filesystem::remove(path);
+
+        const uint8_t block[2]{0xFF, 0x81};
+        Framebuffer framebuffer{};
+        framebuffer.drawPixelData(4, 6, block, 2);
+
+        StreamServer server{"unix:" + path.string()};
+        REQUIRE(server.isOpen());
+        server.publish(framebuffer);
+
+        // A new viewer starts from a keyframe of the last published frame.
+        StreamClient client{"unix:" + path.string()};
+        REQUIRE(client.isOpen());
+
+        RowDeltaDecoder decoder{};
+        REQUIRE(client.receive(decoder));
+        CHECK(sameFrame(framebuffer, decoder));
+        CHECK_EQ(decoder.getSequence(), 1);
+
+        framebuffer.drawPixelData(4, 6, block, 2);
+        server.publish(framebuffer);
+        REQUIRE(client.receive(decoder));
+        CHECK(sameFrame(framebuffer, decoder));
+
+        server.close();
+        CHECK_FALSE(client.receive(decoder));
+        CHECK_EQ(server.stats().published, 2);
+        CHECK_FALSE(std::filesystem::exists(path));
+    }
+}
+#endif
+
+TEST_CASE("Keyboard Integration Test")
+{
+    MockBus bus{};
+    Keyboard keyboard{bus};
+
+    CHECK_EQ(keyboard.getKey(), KEY_NOTPRESSED);
+
+    keyboard.storeKey(SCANCODE_X);
+    CHECK_EQ(keyboard.getKey(), 0x0);
+    keyboard.storeKey(SCANCODE_V);
+    CHECK_EQ(keyboard.getKey(), 0xF);
+    keyboard.storeKey(SCANCODE_UNKNOWN);
+    CHECK_EQ(keyboard.getKey(), KEY_NOTPRESSED);
+}
 
 TEST_CASE("Sound Integration Test") {}
 